@@ -0,0 +1,55 @@
+# Shared board-support library (see hal/README.md)
+#
+# Included by each demo Makefile after it sets:
+#   HAL_BOARD       board file in hal/boards/ (without .board)
+#   HAL_ARCH_FLAGS  target and ABI flags the library is compiled with; they
+#                   must match the consumer's, so each demo builds its own copy
+#   HAL_BUILD_DIR   output directory (default hal_build)
+#   HAL_DEPS        extra prerequisites of the library objects, e.g. a flags stamp
+# and provides:
+#   HAL_CFLAGS      include paths for board_config.h and the HAL headers
+#   HAL_CONFIG      the generated board_config.h (a prerequisite of any object
+#                   that includes it)
+#   HAL_LIB         the static archive to link
+
+HAL_DIR := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+HAL_BUILD_DIR ?= hal_build
+HAL_CC ?= $(CC)
+HAL_AR ?= $(CROSS_COMPILE)gcc-ar
+HAL_DEPS ?=
+
+HAL_CFLAGS = -I$(HAL_DIR)/include -I$(HAL_BUILD_DIR)
+HAL_CONFIG = $(HAL_BUILD_DIR)/board_config.h
+HAL_LIB = $(HAL_BUILD_DIR)/libhal.a
+
+HAL_SOURCES = $(wildcard $(HAL_DIR)/src/*.c)
+HAL_HEADERS = $(wildcard $(HAL_DIR)/include/*.h)
+HAL_OBJECTS = $(patsubst $(HAL_DIR)/src/%.c,$(HAL_BUILD_DIR)/%.o,$(HAL_SOURCES))
+
+HAL_LIB_CFLAGS = -Wall \
+                 -Wextra \
+                 -Wstrict-prototypes \
+                 -Wmissing-prototypes \
+                 -ffreestanding \
+                 -ffunction-sections \
+                 -fdata-sections \
+                 -std=c99 \
+                 -g3 \
+                 $(HAL_CFLAGS)
+
+# Board addresses, IRQ lines, clock and baud from the board file and the
+# Renode platform it names; the .d file tracks the .repl
+$(HAL_CONFIG): $(HAL_DIR)/boards/$(HAL_BOARD).board $(HAL_DIR)/tools/gen_board_config.py
+	@echo "Generating $@ for board $(HAL_BOARD)..."
+	python3 $(HAL_DIR)/tools/gen_board_config.py $< $@
+
+-include $(HAL_CONFIG).d
+
+$(HAL_BUILD_DIR)/%.o: $(HAL_DIR)/src/%.c $(HAL_HEADERS) $(HAL_CONFIG) $(HAL_DEPS)
+	@echo "Compiling $<..."
+	$(HAL_CC) $(HAL_ARCH_FLAGS) $(HAL_LIB_CFLAGS) -c $< -o $@
+
+$(HAL_LIB): $(HAL_OBJECTS)
+	@echo "Archiving $@..."
+	rm -f $@
+	$(HAL_AR) rcs $@ $^
@@ -0,0 +1,26 @@
+/*
+ * Polled Board Console
+ * Minimal blocking output on the UART named by "console" in the board file,
+ * for early boot, fault reports and demos without a full driver. Works
+ * without interrupts; on boards with console = none every call is a no-op.
+ */
+
+#ifndef HAL_CONSOLE_H
+#define HAL_CONSOLE_H
+
+#include <stdint.h>
+#include "board_config.h"
+
+/* Configure the console UART for BOARD_CONSOLE_BAUD, 8N1, polled */
+void hal_console_init(void);
+
+/* Send one character, waiting for room in the transmitter */
+void hal_console_putc(char c);
+
+/* Send len raw bytes (no newline conversion) */
+void hal_console_write(const void* buf, uint32_t len);
+
+/* Send a string, converting "\n" to "\r\n" */
+void hal_console_puts(const char* str);
+
+#endif /* HAL_CONSOLE_H */
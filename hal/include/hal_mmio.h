@@ -0,0 +1,30 @@
+/*
+ * Memory-Mapped I/O Accessors
+ * Every HAL register access goes through these. With a base address from
+ * board_config.h the whole address is a compile-time constant, so each call
+ * compiles to a single load or store at an immediate offset from one
+ * literal-pool base shared by the whole function.
+ */
+
+#ifndef HAL_MMIO_H
+#define HAL_MMIO_H
+
+#include <stdint.h>
+
+static inline uint32_t hal_read32(uintptr_t addr) {
+    return *(volatile uint32_t*)addr;
+}
+
+static inline void hal_write32(uintptr_t addr, uint32_t value) {
+    *(volatile uint32_t*)addr = value;
+}
+
+static inline uint8_t hal_read8(uintptr_t addr) {
+    return *(volatile uint8_t*)addr;
+}
+
+static inline void hal_write8(uintptr_t addr, uint8_t value) {
+    *(volatile uint8_t*)addr = value;
+}
+
+#endif /* HAL_MMIO_H */
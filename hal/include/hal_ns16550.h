@@ -0,0 +1,86 @@
+/*
+ * NS16550 UART Register Interface
+ * Register map and static inline accessors for the 16550-compatible UARTs
+ * of the RISC-V platform. Registers are 8 bits wide on a 4-byte stride.
+ */
+
+#ifndef HAL_NS16550_H
+#define HAL_NS16550_H
+
+#include <stdint.h>
+#include "hal_mmio.h"
+
+/* Register offsets */
+#define NS16550_THR         0x00    /* Transmit Holding Register (write) */
+#define NS16550_RBR         0x00    /* Receive Buffer Register (read) */
+#define NS16550_DLL         0x00    /* Divisor Latch low (DLAB = 1) */
+#define NS16550_IER         0x04    /* Interrupt Enable */
+#define NS16550_DLM         0x04    /* Divisor Latch high (DLAB = 1) */
+#define NS16550_FCR         0x08    /* FIFO Control (write) */
+#define NS16550_LCR         0x0C    /* Line Control */
+#define NS16550_LSR         0x14    /* Line Status */
+
+/* Line Control Register bits */
+#define NS16550_LCR_8N1     0x03    /* 8 data bits, no parity, 1 stop bit */
+#define NS16550_LCR_DLAB    0x80    /* Divisor latch access */
+
+/* FIFO Control Register bits */
+#define NS16550_FCR_ENABLE  0x01    /* Enable FIFOs */
+#define NS16550_FCR_CLEAR   0x06    /* Clear receive and transmit FIFOs */
+
+/* Line Status Register bits */
+#define NS16550_LSR_DR      0x01    /* Data Ready */
+#define NS16550_LSR_THRE    0x20    /* Transmit Holding Register Empty */
+
+/* Divisor latch value: clock / (16 * baud), rounded */
+#define NS16550_DIVISOR(clock_hz, baud) (((clock_hz) + 8u * (baud)) / (16u * (baud)))
+
+/* Nonzero if the 16-bit divisor latch can produce baud from clock_hz
+ * within 1/50 (the same tolerance as PL011_BAUD_OK()) */
+#define NS16550_BAUD_OK(clock_hz, baud) \
+    ((baud) != 0u && \
+     NS16550_DIVISOR(clock_hz, baud) >= 1u && \
+     NS16550_DIVISOR(clock_hz, baud) <= 0xFFFFu && \
+     ((clock_hz) > 16u * (baud) * NS16550_DIVISOR(clock_hz, baud) \
+        ? (clock_hz) - 16u * (baud) * NS16550_DIVISOR(clock_hz, baud) \
+        : 16u * (baud) * NS16550_DIVISOR(clock_hz, baud) - (clock_hz)) * 50u <= (clock_hz))
+
+static inline uint8_t ns16550_read(uintptr_t base, uint32_t reg) {
+    return hal_read8(base + reg);
+}
+
+static inline void ns16550_write(uintptr_t base, uint32_t reg, uint8_t value) {
+    hal_write8(base + reg, value);
+}
+
+/* Nonzero when the transmit holding register can take a character */
+static inline int ns16550_tx_ready(uintptr_t base) {
+    return ns16550_read(base, NS16550_LSR) & NS16550_LSR_THRE;
+}
+
+/* Nonzero when a received character is waiting */
+static inline int ns16550_rx_ready(uintptr_t base) {
+    return ns16550_read(base, NS16550_LSR) & NS16550_LSR_DR;
+}
+
+/* Wait for room and send one character */
+static inline void ns16550_putc(uintptr_t base, char c) {
+    while (!ns16550_tx_ready(base)) {
+        /* Busy-wait: the polled console runs before any interrupt setup */
+    }
+    ns16550_write(base, NS16550_THR, (uint8_t)c);
+}
+
+/* Program 8N1 at the given baud rate with FIFOs enabled, interrupts off */
+static inline void ns16550_configure(uintptr_t base, uint32_t clock_hz, uint32_t baud) {
+    uint32_t divisor = NS16550_DIVISOR(clock_hz, baud);
+
+    ns16550_write(base, NS16550_IER, 0);
+    ns16550_write(base, NS16550_LCR, NS16550_LCR_DLAB);
+    ns16550_write(base, NS16550_DLL, (uint8_t)divisor);
+    ns16550_write(base, NS16550_DLM, (uint8_t)(divisor >> 8));
+    ns16550_write(base, NS16550_LCR, NS16550_LCR_8N1);
+    ns16550_write(base, NS16550_FCR, NS16550_FCR_ENABLE | NS16550_FCR_CLEAR);
+}
+
+#endif /* HAL_NS16550_H */
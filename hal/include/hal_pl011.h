@@ -0,0 +1,130 @@
+/*
+ * ARM PL011 UART Register Interface
+ * Register map and static inline accessors. Pass a constant base (e.g.
+ * BOARD_UART_BASE) and every access folds to one immediate-offset load or
+ * store; no driver state lives here, so interrupt-driven drivers build on
+ * the same accessors as the polled console in hal_console.c.
+ */
+
+#ifndef HAL_PL011_H
+#define HAL_PL011_H
+
+#include <stdint.h>
+#include "hal_mmio.h"
+
+/* Register offsets */
+#define PL011_DR            0x00    /* Data Register */
+#define PL011_FR            0x18    /* Flag Register */
+#define PL011_IBRD          0x24    /* Integer Baud Rate */
+#define PL011_FBRD          0x28    /* Fractional Baud Rate */
+#define PL011_LCRH          0x2C    /* Line Control */
+#define PL011_CR            0x30    /* Control Register */
+#define PL011_IFLS          0x34    /* Interrupt FIFO Level Select */
+#define PL011_IMSC          0x38    /* Interrupt Mask */
+#define PL011_MIS           0x40    /* Masked Interrupt Status */
+#define PL011_ICR           0x44    /* Interrupt Clear */
+
+/* Flag Register bits */
+#define PL011_FR_TXFE       (1u << 7)   /* Transmit FIFO Empty */
+#define PL011_FR_TXFF       (1u << 5)   /* Transmit FIFO Full */
+#define PL011_FR_RXFE       (1u << 4)   /* Receive FIFO Empty */
+#define PL011_FR_BUSY       (1u << 3)   /* UART Busy */
+
+/* Depth of the transmit and receive FIFOs */
+#define PL011_FIFO_DEPTH    16
+
+/* Control Register bits */
+#define PL011_CR_UARTEN     (1u << 0)   /* UART Enable */
+#define PL011_CR_TXE        (1u << 8)   /* Transmit Enable */
+#define PL011_CR_RXE        (1u << 9)   /* Receive Enable */
+
+/* Line Control Register bits */
+#define PL011_LCRH_WLEN8    (3u << 5)   /* 8-bit word length */
+#define PL011_LCRH_FEN      (1u << 4)   /* FIFO Enable */
+
+/* Interrupt bits (IMSC / MIS / ICR) */
+#define PL011_INT_RX        (1u << 4)   /* Receive interrupt */
+#define PL011_INT_TX        (1u << 5)   /* Transmit interrupt */
+#define PL011_INT_RT        (1u << 6)   /* Receive timeout interrupt */
+#define PL011_INT_ALL       0x7FFu
+
+/* FIFO level select: interrupt at 1/8 full (TX drains to, RX fills to) */
+#define PL011_IFLS_TX_1_8   (0u << 0)
+#define PL011_IFLS_RX_1_8   (0u << 3)
+
+/* Baud rate divisor in 1/64 units, rounded: UARTCLK / (16 * baud) * 64.
+ * IBRD takes the integer part and FBRD the 6-bit fraction. These are plain
+ * integer expressions, so constant clock/baud pairs fold to immediates and
+ * can be checked with #if. UARTCLK must stay below 1 GHz (4 * clock_hz
+ * fits in 32 bits). */
+#define PL011_BAUD_DIV(clock_hz, baud)      ((4u * (clock_hz) + (baud) / 2u) / (baud))
+#define PL011_IBRD_VALUE(clock_hz, baud)    (PL011_BAUD_DIV(clock_hz, baud) >> 6)
+#define PL011_FBRD_VALUE(clock_hz, baud)    (PL011_BAUD_DIV(clock_hz, baud) & 0x3Fu)
+
+/* Bit rate the divisor actually produces */
+#define PL011_BAUD_ACTUAL(clock_hz, baud) \
+    ((4u * (clock_hz) + PL011_BAUD_DIV(clock_hz, baud) / 2u) / PL011_BAUD_DIV(clock_hz, baud))
+
+/* Highest rate: IBRD must be at least 1, so baud <= UARTCLK / 16 */
+#define PL011_BAUD_MAX(clock_hz)            ((clock_hz) / 16u)
+
+/* Rate error tolerated, as a fraction 1/N: an 8N1 receiver resynchronizes
+ * on every start bit and samples mid-bit, so about 2% still decodes */
+#define PL011_BAUD_TOLERANCE                50u
+
+/* |requested - produced| scaled by the divisor, in the same units as
+ * PL011_BAUD_DIV(clock_hz, baud) * baud */
+#define PL011_BAUD_DELTA(clock_hz, baud) \
+    (4u * (clock_hz) > PL011_BAUD_DIV(clock_hz, baud) * (baud) \
+        ? 4u * (clock_hz) - PL011_BAUD_DIV(clock_hz, baud) * (baud) \
+        : PL011_BAUD_DIV(clock_hz, baud) * (baud) - 4u * (clock_hz))
+
+/* Nonzero if the divisor registers can produce baud from clock_hz within
+ * the tolerance: IBRD in 1..65535 and the rounding error under 1/50 */
+#define PL011_BAUD_OK(clock_hz, baud) \
+    ((baud) != 0u && \
+     PL011_BAUD_DIV(clock_hz, baud) >= 64u && \
+     PL011_BAUD_DIV(clock_hz, baud) <= 0x3FFFFFu && \
+     PL011_BAUD_DELTA(clock_hz, baud) * PL011_BAUD_TOLERANCE <= PL011_BAUD_DIV(clock_hz, baud) * (baud))
+
+static inline uint32_t pl011_read(uintptr_t base, uint32_t reg) {
+    return hal_read32(base + reg);
+}
+
+static inline void pl011_write(uintptr_t base, uint32_t reg, uint32_t value) {
+    hal_write32(base + reg, value);
+}
+
+/* Nonzero when the transmit FIFO can take another character */
+static inline int pl011_tx_ready(uintptr_t base) {
+    return !(pl011_read(base, PL011_FR) & PL011_FR_TXFF);
+}
+
+/* Nonzero when the receive FIFO holds a character */
+static inline int pl011_rx_ready(uintptr_t base) {
+    return !(pl011_read(base, PL011_FR) & PL011_FR_RXFE);
+}
+
+/* Reprogram the divisors for 8N1 with FIFOs. The PL011 latches IBRD and
+ * FBRD on the following LCRH write, so the line control is rewritten too. */
+static inline void pl011_set_divisor(uintptr_t base, uint32_t ibrd, uint32_t fbrd) {
+    pl011_write(base, PL011_IBRD, ibrd);
+    pl011_write(base, PL011_FBRD, fbrd);
+    pl011_write(base, PL011_LCRH, PL011_LCRH_WLEN8 | PL011_LCRH_FEN);
+}
+
+/* Disable the UART and program the baud rate for a given reference clock;
+ * the caller sets up interrupts and enables it with pl011_enable(). With
+ * constant arguments the divisors are computed at compile time; check
+ * them with PL011_BAUD_OK() first. */
+static inline void pl011_configure(uintptr_t base, uint32_t clock_hz, uint32_t baud) {
+    pl011_write(base, PL011_CR, 0);
+    pl011_set_divisor(base, PL011_IBRD_VALUE(clock_hz, baud), PL011_FBRD_VALUE(clock_hz, baud));
+}
+
+/* Enable the UART with transmitter and receiver */
+static inline void pl011_enable(uintptr_t base) {
+    pl011_write(base, PL011_CR, PL011_CR_UARTEN | PL011_CR_TXE | PL011_CR_RXE);
+}
+
+#endif /* HAL_PL011_H */
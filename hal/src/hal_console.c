@@ -0,0 +1,70 @@
+/*
+ * Polled Board Console
+ * Driver selected at compile time by the BOARD_CONSOLE_* macros of
+ * board_config.h; the base address is a constant, so the loops below touch
+ * the UART with immediate-offset accesses only.
+ */
+
+#include "hal_console.h"
+
+#if defined(BOARD_CONSOLE_PL011)
+#include "hal_pl011.h"
+
+#if !PL011_BAUD_OK(BOARD_CONSOLE_CLOCK_HZ, BOARD_CONSOLE_BAUD)
+#error "console_baud is out of range for the console clock of this board"
+#endif
+
+void hal_console_init(void) {
+    pl011_configure(BOARD_CONSOLE_BASE, BOARD_CONSOLE_CLOCK_HZ, BOARD_CONSOLE_BAUD);
+    pl011_enable(BOARD_CONSOLE_BASE);
+}
+
+void hal_console_putc(char c) {
+    while (!pl011_tx_ready(BOARD_CONSOLE_BASE)) {
+        /* Wait for room in the transmit FIFO */
+    }
+    pl011_write(BOARD_CONSOLE_BASE, PL011_DR, (uint8_t)c);
+}
+
+#elif defined(BOARD_CONSOLE_NS16550)
+#include "hal_ns16550.h"
+
+#if !NS16550_BAUD_OK(BOARD_CONSOLE_CLOCK_HZ, BOARD_CONSOLE_BAUD)
+#error "console_baud is out of range for the console clock of this board"
+#endif
+
+void hal_console_init(void) {
+    ns16550_configure(BOARD_CONSOLE_BASE, BOARD_CONSOLE_CLOCK_HZ, BOARD_CONSOLE_BAUD);
+}
+
+void hal_console_putc(char c) {
+    ns16550_putc(BOARD_CONSOLE_BASE, c);
+}
+
+#else /* BOARD_CONSOLE_NONE */
+
+void hal_console_init(void) {
+}
+
+void hal_console_putc(char c) {
+    (void)c;
+}
+
+#endif
+
+void hal_console_write(const void* buf, uint32_t len) {
+    const char* p = (const char*)buf;
+
+    while (len--) {
+        hal_console_putc(*p++);
+    }
+}
+
+void hal_console_puts(const char* str) {
+    for (; *str; str++) {
+        if (*str == '\n') {
+            hal_console_putc('\r');
+        }
+        hal_console_putc(*str);
+    }
+}
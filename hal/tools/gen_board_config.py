@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""
+Generate board_config.h from a board description (see hal/boards/).
+
+A board file is a list of "key = value" lines:
+
+    platform          Renode platform description, relative to the board file
+    clock.<name>      frequency in Hz of one clock of the board's clock model,
+                      optionally followed by the repl property that must agree
+                      with it (e.g. "100000000 dwt.frequency")
+    console           repl peripheral used by hal_console.h, or "none"
+    console_clock     name of the clock feeding the console UART
+    console_baud      console baud rate
+
+Each clock becomes BOARD_CLOCK_<NAME>_HZ. A clock tied to a repl property
+is checked against the platform, so firmware arithmetic and the simulated
+timers cannot silently disagree; divisors derived from the clocks are
+checked by the driver headers at compile time.
+
+Every peripheral the .repl maps on the system bus becomes BOARD_<NAME>_BASE,
+plus BOARD_<NAME>_SIZE and BOARD_<NAME>_IRQ when the repl gives a size or
+a single interrupt line, so addresses have one source: the platform the
+firmware runs on. The header is only rewritten when its content changes,
+and a make dependency file naming the repl is written next to it.
+
+Usage:
+    hal/tools/gen_board_config.py hal/boards/cortex_m33.board hal_build/board_config.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+BLOCK_RE = re.compile(r"^(\w+):\s*([\w.]+)\s*@\s*sysbus(?:\s+(0x[0-9a-fA-F]+))?")
+PROPERTY_RE = re.compile(r"^\s+(\w+):\s*(\S+)")
+IRQ_RE = re.compile(r"^\s+(?:\d+\s+)?->\s*(\w+)@(\d+)\s*$")
+
+# Console drivers by Renode peripheral type
+CONSOLE_DRIVERS = {"UART.PL011": "PL011", "UART.NS16550": "NS16550"}
+
+
+def read_board(path):
+    """(settings, [(clock name, hz, repl property or None)])"""
+    board = {}
+    clocks = []
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            if "=" not in line:
+                sys.exit(f"{path}:{n}: expected key = value")
+            key, value = (s.strip() for s in line.split("=", 1))
+            if key.startswith("clock."):
+                fields = value.split()
+                try:
+                    hz = int(fields[0], 0)
+                except (IndexError, ValueError):
+                    sys.exit(f"{path}:{n}: expected a frequency in Hz")
+                if hz <= 0 or len(fields) > 2:
+                    sys.exit(f"{path}:{n}: expected <hz> [peripheral.property]")
+                clocks.append((key[len("clock."):], hz, fields[1] if len(fields) == 2 else None))
+            else:
+                board[key] = value
+    if "platform" not in board:
+        sys.exit(f"{path}: no platform")
+    return board, clocks
+
+
+def read_platform(path):
+    """Every block of the repl as {name, type, base, size, irq, properties};
+    base is None for blocks registered without an address (the CPU)."""
+    peripherals = []
+    irq_lines = {}      # name -> [(target, line number on the target)]
+    current = None
+    with open(path) as f:
+        for line in f:
+            line = line.split("//", 1)[0].rstrip()
+            m = BLOCK_RE.match(line)
+            if m:
+                current = {"name": m.group(1), "type": m.group(2),
+                           "base": int(m.group(3), 16) if m.group(3) else None,
+                           "size": None, "irq": None, "properties": {}}
+                peripherals.append(current)
+                irq_lines[m.group(1)] = []
+                continue
+            if line and not line[0].isspace():
+                current = None
+                continue
+            if current is None:
+                continue
+            m = IRQ_RE.match(line)
+            if m:
+                irq_lines[current["name"]].append((m.group(1), int(m.group(2))))
+                continue
+            m = PROPERTY_RE.match(line)
+            if m:
+                current["properties"][m.group(1)] = m.group(2)
+                if m.group(1) == "size":
+                    current["size"] = int(m.group(2), 0)
+
+    # An interrupt number is a line into an interrupt controller (NVIC,
+    # PLIC), and only meaningful for single-line peripherals; the
+    # controllers' own connections to CPU inputs are not IRQ numbers
+    controllers = {p["name"] for p in peripherals if p["type"].startswith("IRQControllers.")}
+    for p in peripherals:
+        lines = [irq for target, irq in irq_lines[p["name"]] if target in controllers]
+        if len(lines) == 1:
+            p["irq"] = lines[0]
+    return peripherals
+
+
+def check_clocks(board_path, clocks, platform_path, peripherals):
+    """Exit if a clock disagrees with the repl property it is tied to."""
+    by_name = {p["name"]: p for p in peripherals}
+    for name, hz, source in clocks:
+        if source is None:
+            continue
+        block, _, prop = source.partition(".")
+        value = by_name.get(block, {}).get("properties", {}).get(prop)
+        if value is None:
+            sys.exit(f"{board_path}: clock.{name}: {source} is not set in {platform_path}")
+        if int(value, 0) != hz:
+            sys.exit(f"{board_path}: clock.{name} = {hz} Hz, but {platform_path} "
+                     f"sets {source} to {int(value, 0)} Hz")
+
+
+def generate(board_path, board, clocks, platform_path, peripherals):
+    name = os.path.splitext(os.path.basename(board_path))[0]
+    guard = "BOARD_CONFIG_H"
+    out = [
+        "/*",
+        f" * Board configuration: {name}",
+        f" * Generated by hal/tools/gen_board_config.py from boards/{name}.board",
+        f" * and {os.path.basename(platform_path)}; do not edit.",
+        " */",
+        "",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        f"#define BOARD_NAME                  \"{name}\"",
+    ]
+
+    if clocks:
+        out += ["", "/* Clock model */"]
+    for clock, hz, source in clocks:
+        macro = f"BOARD_CLOCK_{clock.upper()}_HZ"
+        value = f"{hz}u"
+        out.append(f"#define {macro:<27} {value:<12}/* {source} */" if source
+                   else f"#define {macro:<27} {value}")
+
+    out += ["", f"/* Peripherals of {os.path.basename(platform_path)} */"]
+    for p in peripherals:
+        if p["base"] is None:
+            continue
+        prefix = "BOARD_" + p["name"].upper()
+        out.append(f"#define {prefix + '_BASE':<27} 0x{p['base']:08X}u")
+        if p["size"] is not None:
+            out.append(f"#define {prefix + '_SIZE':<27} 0x{p['size']:08X}u")
+        if p["irq"] is not None:
+            out.append(f"#define {prefix + '_IRQ':<27} {p['irq']}")
+
+    console = board.get("console", "none")
+    out += ["", "/* Console UART (hal_console.h) */"]
+    if console == "none":
+        out.append("#define BOARD_CONSOLE_NONE          1")
+    else:
+        match = [p for p in peripherals if p["name"] == console]
+        if not match:
+            sys.exit(f"{board_path}: console \"{console}\" is not in {platform_path}")
+        driver = CONSOLE_DRIVERS.get(match[0]["type"])
+        if driver is None:
+            sys.exit(f"{board_path}: no console driver for {match[0]['type']}")
+        for key in ("console_clock", "console_baud"):
+            if key not in board:
+                sys.exit(f"{board_path}: console needs {key}")
+        clock = board["console_clock"]
+        if clock not in (c[0] for c in clocks):
+            sys.exit(f"{board_path}: console_clock \"{clock}\" is not a clock.* entry")
+        out += [
+            f"#define BOARD_CONSOLE_{driver:<13} 1",
+            f"#define BOARD_CONSOLE_BASE          BOARD_{console.upper()}_BASE",
+            f"#define BOARD_CONSOLE_CLOCK_HZ      BOARD_CLOCK_{clock.upper()}_HZ",
+            f"#define BOARD_CONSOLE_BAUD          {int(board['console_baud'])}u",
+        ]
+
+    out += ["", f"#endif /* {guard} */", ""]
+    return "\n".join(out)
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate board_config.h")
+    parser.add_argument("board", help="board description (hal/boards/*.board)")
+    parser.add_argument("header", help="output header")
+    args = parser.parse_args()
+
+    board, clocks = read_board(args.board)
+    platform = os.path.normpath(os.path.join(os.path.dirname(args.board), board["platform"]))
+    peripherals = read_platform(platform)
+    check_clocks(args.board, clocks, platform, peripherals)
+
+    os.makedirs(os.path.dirname(args.header) or ".", exist_ok=True)
+    write_if_changed(args.header, generate(args.board, board, clocks, platform, peripherals))
+    write_if_changed(args.header + ".d", f"{args.header}: {platform}\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+/*
+ * Bump Arena Allocator
+ */
+
+#include "arena.h"
+#include "uart_printf.h"
+
+/* Heap boundaries from linker_m33.ld */
+extern uint8_t _heap_start[];
+extern uint8_t _heap_end[];
+
+void arena_init(arena_t* arena, const char* name, void* mem, uint32_t size) {
+    arena->name = name;
+    arena->base = (uint8_t*)mem;
+    arena->size = size;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->failures = 0;
+}
+
+void arena_init_heap(arena_t* arena) {
+    arena_init(arena, "heap", _heap_start, (uint32_t)(_heap_end - _heap_start));
+}
+
+void* arena_alloc(arena_t* arena, uint32_t size, uint32_t align) {
+    uintptr_t start = ((uintptr_t)arena->base + arena->used + align - 1) & ~(uintptr_t)(align - 1);
+    uint32_t offset = (uint32_t)(start - (uintptr_t)arena->base);
+
+    if (offset > arena->size || size > arena->size - offset) {
+        arena->failures++;
+        return 0;
+    }
+
+    arena->used = offset + size;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return (void*)start;
+}
+
+arena_mark_t arena_mark(const arena_t* arena) {
+    return arena->used;
+}
+
+void arena_release(arena_t* arena, arena_mark_t mark) {
+    if (mark <= arena->used) {
+        arena->used = mark;
+    }
+}
+
+void arena_reset(arena_t* arena) {
+    arena->used = 0;
+}
+
+void arena_report(const arena_t* arena) {
+    uart_printf("Arena %-8s %6u bytes: used %u, peak %u, failed %u\n",
+                arena->name, arena->size, arena->used, arena->peak, arena->failures);
+}
@@ -0,0 +1,46 @@
+/*
+ * Bump Arena Allocator
+ * Allocation advances an offset through one buffer, so it is O(1) and
+ * never fragments. Memory is given back in bulk: arena_mark() saves the
+ * offset and arena_release() rolls back to it, freeing everything that
+ * was allocated in between (a scope). An arena belongs to one context;
+ * share pools, not arenas, with interrupt handlers.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+
+typedef struct {
+    const char* name;
+    uint8_t* base;
+    uint32_t size;
+    uint32_t used;          /* bytes allocated, including alignment padding */
+    uint32_t peak;          /* highest used seen */
+    uint32_t failures;      /* allocations refused for lack of space */
+} arena_t;
+
+/* Saved allocation offset */
+typedef uint32_t arena_mark_t;
+
+/* Manage size bytes at mem */
+void arena_init(arena_t* arena, const char* name, void* mem, uint32_t size);
+
+/* Manage the whole heap between _heap_start and _heap_end (linker_m33.ld) */
+void arena_init_heap(arena_t* arena);
+
+/* Allocate size bytes aligned to align (a power of two), or return null */
+void* arena_alloc(arena_t* arena, uint32_t size, uint32_t align);
+
+/* Save the current offset / free everything allocated since the mark */
+arena_mark_t arena_mark(const arena_t* arena);
+void arena_release(arena_t* arena, arena_mark_t mark);
+
+/* Free everything */
+void arena_reset(arena_t* arena);
+
+/* Print occupancy statistics over the UART */
+void arena_report(const arena_t* arena);
+
+#endif /* ARENA_H */
@@ -0,0 +1,43 @@
+/*
+ * CoreMark-Style CPU Benchmark
+ * Four integer kernels in the spirit of CoreMark: linked-list traversal
+ * and sorting, matrix arithmetic, a token-classifying state machine and
+ * CRC computation. Each kernel run returns a CRC-16 of its results, so
+ * a miscompiled or mis-emulated kernel is caught by comparing the result
+ * of seed 0 against a value computed on the host.
+ */
+
+#ifndef CORE_H
+#define CORE_H
+
+#include <stdint.h>
+#include "board_config.h"
+
+/* Timed iterations of each kernel (one iteration = one run of all four) */
+#ifndef CORE_ITERATIONS
+#define CORE_ITERATIONS     2000
+#endif
+
+/* Core clock used to turn DWT cycles into simulated seconds
+ * (the board clock model, checked against the DWT frequency in the repl) */
+#define CORE_CPU_HZ         BOARD_CLOCK_CPU_HZ
+
+/* CRC-16/CCITT update with one byte, and with a 16-bit value (low byte first) */
+uint16_t core_crc16_u8(uint16_t crc, uint8_t data);
+uint16_t core_crc16_u16(uint16_t crc, uint16_t data);
+
+/* Kernels: set up static data once, then run with any seed.
+ * A run leaves the kernel's data ready for the next one. */
+void core_list_init(void);
+uint16_t core_list_run(uint32_t seed);
+
+void core_matrix_init(void);
+uint16_t core_matrix_run(uint32_t seed);
+
+void core_state_init(void);
+uint16_t core_state_run(uint32_t seed);
+
+void core_crc_init(void);
+uint16_t core_crc_run(uint32_t seed);
+
+#endif /* CORE_H */
@@ -0,0 +1,57 @@
+/*
+ * CRC Kernel
+ * Bitwise CRC-32 (reflected, polynomial 0xEDB88320) over a buffer that
+ * changes with the seed: a tight loop of shifts, XORs and a data-dependent
+ * branch per bit. The bitwise CRC-16 below also checksums every kernel.
+ */
+
+#include "core.h"
+
+#define CORE_CRC_BUF_SIZE   256
+
+static uint8_t crc_buf[CORE_CRC_BUF_SIZE];
+
+uint16_t core_crc16_u8(uint16_t crc, uint8_t data) {
+    crc ^= (uint16_t)(data << 8);
+    for (uint32_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+uint16_t core_crc16_u16(uint16_t crc, uint16_t data) {
+    crc = core_crc16_u8(crc, (uint8_t)data);
+    return core_crc16_u8(crc, (uint8_t)(data >> 8));
+}
+
+static uint32_t crc32(const uint8_t* p, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *p++;
+        for (uint32_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+void core_crc_init(void) {
+    for (uint32_t i = 0; i < CORE_CRC_BUF_SIZE; i++) {
+        crc_buf[i] = (uint8_t)(i * 37 + 11);
+    }
+}
+
+uint16_t core_crc_run(uint32_t seed) {
+    uint32_t crc;
+
+    /* Perturb a few bytes so every seed checksums different data, and
+     * undo it afterwards so the buffer is the same for the next run */
+    crc_buf[seed & (CORE_CRC_BUF_SIZE - 1)] ^= (uint8_t)seed;
+    crc_buf[(seed * 7) & (CORE_CRC_BUF_SIZE - 1)] ^= 0x5A;
+    crc = crc32(crc_buf, CORE_CRC_BUF_SIZE);
+    crc_buf[(seed * 7) & (CORE_CRC_BUF_SIZE - 1)] ^= 0x5A;
+    crc_buf[seed & (CORE_CRC_BUF_SIZE - 1)] ^= (uint8_t)seed;
+
+    return core_crc16_u16(core_crc16_u16(0, (uint16_t)crc), (uint16_t)(crc >> 16));
+}
@@ -0,0 +1,132 @@
+/*
+ * Linked-List Kernel
+ * Pointer chasing over a singly linked list of small records: in-place
+ * reversal, a merge sort by a seed-dependent value, keyed searches, and a
+ * sort back into key order, which is where every run starts.
+ */
+
+#include "core.h"
+
+#define CORE_LIST_NODES     64
+#define CORE_LIST_FINDS     8
+
+typedef struct core_node {
+    struct core_node* next;
+    int16_t key;
+    int16_t value;
+} core_node_t;
+
+static core_node_t list_nodes[CORE_LIST_NODES];
+static core_node_t* list_head;
+
+/* Position of key in the list, or -1 */
+static int32_t list_find(const core_node_t* node, int16_t key) {
+    for (int32_t pos = 0; node; node = node->next, pos++) {
+        if (node->key == key) {
+            return pos;
+        }
+    }
+    return -1;
+}
+
+static core_node_t* list_reverse(core_node_t* node) {
+    core_node_t* prev = 0;
+
+    while (node) {
+        core_node_t* next = node->next;
+        node->next = prev;
+        prev = node;
+        node = next;
+    }
+    return prev;
+}
+
+static int list_before(const core_node_t* a, const core_node_t* b, int by_value) {
+    if (by_value && a->value != b->value) {
+        return a->value < b->value;
+    }
+    return a->key <= b->key;
+}
+
+/* Bottom-up merge sort (stable, no recursion, no extra memory) */
+static core_node_t* list_sort(core_node_t* head, int by_value) {
+    for (uint32_t width = 1; ; width *= 2) {
+        core_node_t* rest = head;
+        core_node_t* tail = 0;
+        uint32_t merges = 0;
+
+        head = 0;
+        while (rest) {
+            core_node_t* a = rest;
+            core_node_t* b = rest;
+            uint32_t a_len = 0;
+            uint32_t b_len = width;
+
+            merges++;
+            while (b && a_len < width) {
+                a_len++;
+                b = b->next;
+            }
+            while (a_len || (b_len && b)) {
+                core_node_t* take;
+
+                if (a_len && (!b_len || !b || list_before(a, b, by_value))) {
+                    take = a;
+                    a = a->next;
+                    a_len--;
+                } else {
+                    take = b;
+                    b = b->next;
+                    b_len--;
+                }
+                if (tail) {
+                    tail->next = take;
+                } else {
+                    head = take;
+                }
+                tail = take;
+            }
+            rest = b;
+        }
+        tail->next = 0;
+
+        if (merges <= 1) {
+            return head;
+        }
+    }
+}
+
+void core_list_init(void) {
+    /* Keys are a fixed permutation of 0..63 (odd multiplier mod 64),
+     * linked in array order and then sorted */
+    for (uint32_t i = 0; i < CORE_LIST_NODES; i++) {
+        list_nodes[i].key = (int16_t)((i * 29 + 5) & (CORE_LIST_NODES - 1));
+        list_nodes[i].value = 0;
+        list_nodes[i].next = i + 1 < CORE_LIST_NODES ? &list_nodes[i + 1] : 0;
+    }
+    list_head = list_sort(&list_nodes[0], 0);
+}
+
+uint16_t core_list_run(uint32_t seed) {
+    uint16_t crc = 0;
+
+    for (core_node_t* node = list_head; node; node = node->next) {
+        node->value = (int16_t)(((uint32_t)node->key * 0x9E37u ^ seed * 0x5BD1u) & 0x7FFF);
+    }
+
+    list_head = list_reverse(list_head);
+    crc = core_crc16_u16(crc, (uint16_t)list_head->key);
+
+    list_head = list_sort(list_head, 1);
+    for (uint32_t i = 0; i < CORE_LIST_FINDS; i++) {
+        int32_t pos = list_find(list_head, (int16_t)((seed * 7 + i * 13) & (CORE_LIST_NODES - 1)));
+        crc = core_crc16_u16(crc, (uint16_t)pos);
+    }
+    for (core_node_t* node = list_head; node; node = node->next) {
+        crc = core_crc16_u16(crc, (uint16_t)node->value);
+    }
+
+    /* Back to key order for the next run */
+    list_head = list_sort(list_head, 0);
+    return core_crc16_u16(crc, (uint16_t)list_head->key);
+}
@@ -0,0 +1,86 @@
+/*
+ * CoreMark-Style Benchmark Image
+ * Validates every kernel against its host-computed seed 0 result, then
+ * times CORE_ITERATIONS runs of each with the DWT cycle counter and
+ * reports over the UART, one "core" line per result, ending with
+ * "core done". tools/bench.sh turns the lines into bench_results.json.
+ */
+
+#include "core.h"
+#include "../uart_printf.h"
+#include "../cortex_m33.h"
+
+typedef struct {
+    const char* name;
+    void (*init)(void);
+    uint16_t (*run)(uint32_t seed);
+    uint16_t expected;      /* result of run(0) */
+} core_kernel_t;
+
+static const core_kernel_t core_kernels[] = {
+    { "list",   core_list_init,     core_list_run,      0x5286 },
+    { "matrix", core_matrix_init,   core_matrix_run,    0xE6D3 },
+    { "state",  core_state_init,    core_state_run,     0x2308 },
+    { "crc",    core_crc_init,      core_crc_run,       0xB8AF },
+};
+
+#define CORE_KERNEL_COUNT   (sizeof(core_kernels) / sizeof(core_kernels[0]))
+
+/* Keeps the results from being optimized away */
+static volatile uint16_t core_sink;
+
+/* Function prototype for SystemInit */
+void SystemInit(void);
+
+void SystemInit(void) {
+    dwt_cycle_counter_enable();
+}
+
+/* Iterations per simulated second, scaled by 100 for "%.2k" */
+static int32_t core_rate(uint32_t iterations, uint32_t cycles) {
+    return (int32_t)((uint64_t)iterations * CORE_CPU_HZ * 100 / (cycles ? cycles : 1));
+}
+
+int main(void) {
+    uint32_t total = 0;
+    uint32_t failures = 0;
+
+    uart_init();
+    uart_printf("core compiler=%s\n", __VERSION__);
+    uart_printf("core iterations=%u cpu_hz=%u\n", (uint32_t)CORE_ITERATIONS, CORE_CPU_HZ);
+
+    for (uint32_t k = 0; k < CORE_KERNEL_COUNT; k++) {
+        const core_kernel_t* kernel = &core_kernels[k];
+        uint16_t crc = 0;
+        uint16_t check;
+        uint32_t start;
+        uint32_t cycles;
+
+        kernel->init();
+        check = kernel->run(0);
+
+        start = dwt_cycles();
+        for (uint32_t i = 0; i < CORE_ITERATIONS; i++) {
+            crc = core_crc16_u16(crc, kernel->run(i));
+        }
+        cycles = dwt_cycles() - start;
+        total += cycles;
+        core_sink = crc;
+
+        if (check != kernel->expected) {
+            failures++;
+        }
+        uart_printf("core kernel=%s cycles=%u per_sec=%.2k crc=0x%04x check=0x%04x status=%s\n",
+                    kernel->name, cycles, core_rate(CORE_ITERATIONS, cycles), crc, check,
+                    check == kernel->expected ? "ok" : "FAIL");
+    }
+
+    uart_printf("core total cycles=%u per_sec=%.2k status=%s\n",
+                total, core_rate(CORE_ITERATIONS, total), failures ? "FAIL" : "ok");
+    uart_printf("core done\n");
+    uart_flush();
+
+    while (1) {
+        cpu_wfi();
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Matrix Kernel
+ * 16x16 16-bit matrices multiplied into a 32-bit result, then reduced by
+ * rows with a saturating accumulate and a bit-field extraction: the
+ * multiply-accumulate and load/store mix of fixed-point signal code.
+ */
+
+#include "core.h"
+
+#define CORE_MATRIX_N       16
+
+static int16_t matrix_a[CORE_MATRIX_N][CORE_MATRIX_N];
+static int16_t matrix_b[CORE_MATRIX_N][CORE_MATRIX_N];
+static int32_t matrix_c[CORE_MATRIX_N][CORE_MATRIX_N];
+
+void core_matrix_init(void) {
+    for (uint32_t i = 0; i < CORE_MATRIX_N; i++) {
+        for (uint32_t j = 0; j < CORE_MATRIX_N; j++) {
+            matrix_b[i][j] = (int16_t)((int32_t)((i * 5 + j * 3) & 0x3F) - 32);
+        }
+    }
+}
+
+uint16_t core_matrix_run(uint32_t seed) {
+    uint32_t lcg = seed * 2654435761u + 1;
+    uint16_t crc = 0;
+
+    /* A changes with the seed; values stay small enough that sums fit */
+    for (uint32_t i = 0; i < CORE_MATRIX_N; i++) {
+        for (uint32_t j = 0; j < CORE_MATRIX_N; j++) {
+            lcg = lcg * 1664525u + 1013904223u;
+            matrix_a[i][j] = (int16_t)((int32_t)(lcg >> 22) - 512);
+        }
+    }
+
+    for (uint32_t i = 0; i < CORE_MATRIX_N; i++) {
+        for (uint32_t j = 0; j < CORE_MATRIX_N; j++) {
+            int32_t sum = 0;
+
+            for (uint32_t k = 0; k < CORE_MATRIX_N; k++) {
+                sum += (int32_t)matrix_a[i][k] * matrix_b[k][j];
+            }
+            matrix_c[i][j] = sum;
+        }
+    }
+
+    for (uint32_t i = 0; i < CORE_MATRIX_N; i++) {
+        int32_t acc = 0;
+        uint32_t bits = 0;
+
+        for (uint32_t j = 0; j < CORE_MATRIX_N; j++) {
+            int32_t v = matrix_c[i][j];
+
+            /* Saturate the row sum to 24 bits */
+            acc += v;
+            if (acc > 0x7FFFFF) {
+                acc = 0x7FFFFF;
+            } else if (acc < -0x800000) {
+                acc = -0x800000;
+            }
+            bits += ((uint32_t)v >> 4) & 0xFF;
+        }
+        crc = core_crc16_u16(crc, (uint16_t)acc);
+        crc = core_crc16_u16(crc, (uint16_t)bits);
+    }
+    return crc;
+}
@@ -0,0 +1,131 @@
+/*
+ * State-Machine Kernel
+ * Classifies comma-separated tokens ("42", "-7", "3.25", "6e-3", "x9")
+ * with a table-driven state machine and counts the final state of
+ * every token and every state transition: branchy, byte-at-a-time code
+ * that is hard to predict.
+ */
+
+#include "core.h"
+
+#define CORE_STATE_INPUTS   8
+#define CORE_STATE_LEN      256
+
+typedef enum {
+    ST_START,
+    ST_SIGN,
+    ST_INT,
+    ST_POINT,
+    ST_FLOAT,
+    ST_EXP,
+    ST_EXP_SIGN,
+    ST_SCI,
+    ST_INVALID,
+    ST_COUNT
+} core_state_t;
+
+static char state_inputs[CORE_STATE_INPUTS][CORE_STATE_LEN];
+
+static const char* const state_tokens[] = {
+    "0", "42", "-7", "+19", "3.25", "-0.5", "6e3", "1.5e-3", "2E+9", "x9",
+    "1.2.3", "--4", "7e", ".", "8.", "100000",
+};
+
+#define CORE_STATE_TOKEN_COUNT  (sizeof(state_tokens) / sizeof(state_tokens[0]))
+
+void core_state_init(void) {
+    for (uint32_t n = 0; n < CORE_STATE_INPUTS; n++) {
+        char* p = state_inputs[n];
+        char* end = p + CORE_STATE_LEN - 1;
+        uint32_t pick = n * 5 + 3;
+
+        /* Fill with tokens chosen by a small LCG until the buffer is full */
+        for (;;) {
+            const char* token;
+
+            pick = pick * 1103515245u + 12345u;
+            token = state_tokens[(pick >> 16) % CORE_STATE_TOKEN_COUNT];
+            while (*token && p < end - 1) {
+                *p++ = *token++;
+            }
+            if (*token || p >= end - 1) {
+                break;
+            }
+            *p++ = ',';
+        }
+        *p = '\0';
+    }
+}
+
+/* Character classes */
+enum {
+    CL_DIGIT,
+    CL_SIGN,
+    CL_POINT,
+    CL_EXP,
+    CL_OTHER,
+    CL_COUNT
+};
+
+/* Next state for each state and character class */
+static const uint8_t state_table[ST_COUNT][CL_COUNT] = {
+    /*               digit      sign         point       exp         other */
+    [ST_START]    = { ST_INT,   ST_SIGN,     ST_POINT,   ST_INVALID, ST_INVALID },
+    [ST_SIGN]     = { ST_INT,   ST_INVALID,  ST_POINT,   ST_INVALID, ST_INVALID },
+    [ST_INT]      = { ST_INT,   ST_INVALID,  ST_POINT,   ST_EXP,     ST_INVALID },
+    [ST_POINT]    = { ST_FLOAT, ST_INVALID,  ST_INVALID, ST_INVALID, ST_INVALID },
+    [ST_FLOAT]    = { ST_FLOAT, ST_INVALID,  ST_INVALID, ST_EXP,     ST_INVALID },
+    [ST_EXP]      = { ST_SCI,   ST_EXP_SIGN, ST_INVALID, ST_INVALID, ST_INVALID },
+    [ST_EXP_SIGN] = { ST_SCI,   ST_INVALID,  ST_INVALID, ST_INVALID, ST_INVALID },
+    [ST_SCI]      = { ST_SCI,   ST_INVALID,  ST_INVALID, ST_INVALID, ST_INVALID },
+    [ST_INVALID]  = { ST_INVALID, ST_INVALID, ST_INVALID, ST_INVALID, ST_INVALID },
+};
+
+static uint32_t state_class(char c) {
+    if (c >= '0' && c <= '9') {
+        return CL_DIGIT;
+    }
+    if (c == '+' || c == '-') {
+        return CL_SIGN;
+    }
+    if (c == '.') {
+        return CL_POINT;
+    }
+    if (c == 'e' || c == 'E') {
+        return CL_EXP;
+    }
+    return CL_OTHER;
+}
+
+uint16_t core_state_run(uint32_t seed) {
+    const char* p = state_inputs[seed % CORE_STATE_INPUTS];
+    uint16_t finals[ST_COUNT] = { 0 };
+    uint16_t transitions[ST_COUNT] = { 0 };
+    core_state_t state = ST_START;
+    uint16_t crc = 0;
+
+    for (;; p++) {
+        char c = *p;
+
+        if (c == ',' || c == '\0') {
+            finals[state]++;
+            state = ST_START;
+            if (c == '\0') {
+                break;
+            }
+            continue;
+        }
+
+        core_state_t next = (core_state_t)state_table[state][state_class(c)];
+        if (next != state) {
+            transitions[next]++;
+        }
+        state = next;
+    }
+
+    for (uint32_t i = 0; i < ST_COUNT; i++) {
+        crc = core_crc16_u16(crc, finals[i]);
+        crc = core_crc16_u16(crc, transitions[i]);
+    }
+    return crc;
+}
@@ -0,0 +1,207 @@
+/*
+ * UART Command Shell
+ * Input is taken from the receive ring without blocking and echoed as it
+ * arrives. Lines are normalized while they are assembled (leading and
+ * repeated spaces dropped), so the name lookup only has to consider the
+ * first word and the first two words of a line.
+ */
+
+#include "cmd.h"
+#include "uart_pl011.h"
+#include "uart_printf.h"
+
+#if (CMD_HASH_SLOTS & (CMD_HASH_SLOTS - 1)) != 0 || CMD_HASH_SLOTS > 255
+#error "CMD_HASH_SLOTS must be a power of two below 256"
+#endif
+
+/* Seeds tried by cmd_init() before giving up */
+#define CMD_SEED_TRIES      1024u
+
+/* Installed table and its hash: slot holds table index + 1, 0 when empty */
+static const cmd_t* cmd_table;
+static uint32_t cmd_count;
+static uint32_t cmd_seed;
+static uint8_t cmd_slots[CMD_HASH_SLOTS];
+
+/* Line being assembled */
+static char cmd_line[CMD_LINE_MAX + 1];
+static uint32_t cmd_len;
+static int cmd_overflow;
+
+/* FNV-1a over len bytes, with a final fold so the low bits see the high ones */
+static uint32_t cmd_hash(const char* s, uint32_t len, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+
+    while (len--) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h ^ (h >> 16);
+}
+
+static uint32_t cmd_strlen(const char* s) {
+    const char* p = s;
+
+    while (*p) {
+        p++;
+    }
+    return (uint32_t)(p - s);
+}
+
+/* Try to place every name under seed; fails on the first shared slot */
+static int cmd_place(uint32_t seed) {
+    for (uint32_t i = 0; i < CMD_HASH_SLOTS; i++) {
+        cmd_slots[i] = 0;
+    }
+
+    for (uint32_t i = 0; i < cmd_count; i++) {
+        const char* name = cmd_table[i].name;
+        uint32_t slot = cmd_hash(name, cmd_strlen(name), seed) & (CMD_HASH_SLOTS - 1);
+
+        if (cmd_slots[slot]) {
+            return -1;
+        }
+        cmd_slots[slot] = (uint8_t)(i + 1);
+    }
+    return 0;
+}
+
+int cmd_init(const cmd_t* table, uint32_t count) {
+    cmd_table = table;
+    cmd_count = count;
+    cmd_len = 0;
+    cmd_overflow = 0;
+
+    if (count < CMD_HASH_SLOTS) {
+        for (uint32_t seed = 0; seed < CMD_SEED_TRIES; seed++) {
+            if (cmd_place(seed) == 0) {
+                cmd_seed = seed;
+                return 0;
+            }
+        }
+    }
+
+    cmd_count = 0;
+    cmd_place(0);
+    return -1;
+}
+
+/* The command named exactly by the len bytes at s, or null */
+static const cmd_t* cmd_lookup(const char* s, uint32_t len) {
+    uint32_t index = cmd_slots[cmd_hash(s, len, cmd_seed) & (CMD_HASH_SLOTS - 1)];
+    const char* name;
+
+    if (index == 0) {
+        return 0;
+    }
+
+    name = cmd_table[index - 1].name;
+    for (uint32_t i = 0; i < len; i++) {
+        if (name[i] != s[i]) {
+            return 0;
+        }
+    }
+    return name[len] == '\0' ? &cmd_table[index - 1] : 0;
+}
+
+/* Dispatch a normalized line: try its first two words as a name, then its first word */
+static void cmd_execute(char* line, uint32_t len) {
+    uint32_t first = 0;
+    uint32_t second;
+    const cmd_t* cmd = 0;
+    uint32_t name_len = 0;
+
+    while (first < len && line[first] != ' ') {
+        first++;
+    }
+    second = first;
+    if (second < len) {
+        second++;
+        while (second < len && line[second] != ' ') {
+            second++;
+        }
+        cmd = cmd_lookup(line, second);
+        name_len = second;
+    }
+    if (!cmd) {
+        cmd = cmd_lookup(line, first);
+        name_len = first;
+    }
+
+    if (!cmd) {
+        uart_printf("unknown command \"%s\" (try \"help\")\n", line);
+        return;
+    }
+    cmd->handler(name_len < len ? line + name_len + 1 : line + len);
+}
+
+void cmd_poll(void) {
+    int c;
+
+    while ((c = uart_getchar()) >= 0) {
+        if (c == '\r' || c == '\n') {
+            if (cmd_len == 0 && !cmd_overflow) {
+                /* Blank line, or the "\n" of a "\r\n" pair */
+                continue;
+            }
+            uart_write("\r\n", 2);
+
+            /* Drop a trailing space left by the normalization */
+            if (cmd_len && cmd_line[cmd_len - 1] == ' ') {
+                cmd_len--;
+            }
+            cmd_line[cmd_len] = '\0';
+
+            if (cmd_overflow) {
+                uart_printf("line too long (max %u characters)\n", (uint32_t)CMD_LINE_MAX);
+            } else if (cmd_len) {
+                cmd_execute(cmd_line, cmd_len);
+            }
+            cmd_len = 0;
+            cmd_overflow = 0;
+        } else if (c == '\b' || c == 0x7F) {
+            if (cmd_len) {
+                cmd_len--;
+                uart_write("\b \b", 3);
+            }
+        } else if (c >= ' ' && c < 0x7F) {
+            if (c == ' ' && (cmd_len == 0 || cmd_line[cmd_len - 1] == ' ')) {
+                continue;
+            }
+            if (cmd_len == CMD_LINE_MAX) {
+                cmd_overflow = 1;
+                continue;
+            }
+            cmd_line[cmd_len++] = (char)c;
+            uart_write(&cmd_line[cmd_len - 1], 1);
+        }
+    }
+}
+
+void cmd_help(void) {
+    for (uint32_t i = 0; i < cmd_count; i++) {
+        uart_printf("  %-16s %s\n", cmd_table[i].name, cmd_table[i].usage);
+    }
+}
+
+int cmd_parse_u32(const char* args, uint32_t* value) {
+    uint32_t result = 0;
+
+    if (*args < '0' || *args > '9') {
+        return -1;
+    }
+    for (; *args >= '0' && *args <= '9'; args++) {
+        uint32_t digit = (uint32_t)(*args - '0');
+
+        if (result > (UINT32_MAX - digit) / 10) {
+            return -1;
+        }
+        result = result * 10 + digit;
+    }
+    if (*args != '\0' && *args != ' ') {
+        return -1;
+    }
+
+    *value = result;
+    return 0;
+}
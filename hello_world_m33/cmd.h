@@ -0,0 +1,46 @@
+/*
+ * UART Command Shell
+ * Assembles characters from the UART receive ring into lines and
+ * dispatches each line through a table of named commands. A command name
+ * is one or two words ("stats", "set rate"); whatever follows the name is
+ * passed to the handler as its argument string.
+ *
+ * Lookup is O(1): cmd_init() picks a hash seed under which every name in
+ * the table lands in its own slot (a perfect hash), so dispatching a line
+ * costs one hash and one string compare per candidate name length.
+ */
+
+#ifndef CMD_H
+#define CMD_H
+
+#include <stdint.h>
+
+/* Longest accepted command line, excluding the terminator */
+#define CMD_LINE_MAX        63
+
+/* Hash slots (a power of two, comfortably above the number of commands) */
+#define CMD_HASH_SLOTS      16
+
+typedef struct {
+    const char* name;                       /* one or two words */
+    const char* usage;                      /* shown by cmd_help() */
+    void (*handler)(const char* args);      /* args: text after the name, never null */
+} cmd_t;
+
+/* Install a command table and build its perfect hash.
+ * Returns 0 on success, -1 if the table is too large or no seed separates
+ * every name (add slots or rename a command). */
+int cmd_init(const cmd_t* table, uint32_t count);
+
+/* Consume every received character, echo it and dispatch completed lines.
+ * Never waits for input; call it from the main loop. */
+void cmd_poll(void);
+
+/* Print the name and usage of every installed command */
+void cmd_help(void);
+
+/* Parse an unsigned decimal argument; returns 0 on success, -1 if args
+ * is empty, not a number or out of range */
+int cmd_parse_u32(const char* args, uint32_t* value);
+
+#endif /* CMD_H */
@@ -0,0 +1,111 @@
+/*
+ * ARM Cortex-M33 Core Peripheral Definitions
+ * Minimal register map and intrinsics shared by the demo drivers.
+ */
+
+#ifndef CORTEX_M33_H
+#define CORTEX_M33_H
+
+#include <stdint.h>
+
+/* NVIC registers (System Control Space at 0xE000E000) */
+#define NVIC_ISER(n)    (*(volatile uint32_t*)(0xE000E100 + 4 * (n)))  /* Interrupt Set-Enable */
+#define NVIC_ICER(n)    (*(volatile uint32_t*)(0xE000E180 + 4 * (n)))  /* Interrupt Clear-Enable */
+#define NVIC_IPR(n)     (*(volatile uint8_t*)(0xE000E400 + (n)))       /* Interrupt Priority (byte) */
+
+/* SysTick registers */
+#define SYST_CSR        (*(volatile uint32_t*)0xE000E010)   /* Control and Status */
+#define SYST_RVR        (*(volatile uint32_t*)0xE000E014)   /* Reload Value */
+#define SYST_CVR        (*(volatile uint32_t*)0xE000E018)   /* Current Value */
+#define SYST_CSR_ENABLE     (1u << 0)                       /* Counter enable */
+#define SYST_CSR_TICKINT    (1u << 1)                       /* Interrupt on wrap to zero */
+#define SYST_CSR_CLKSOURCE  (1u << 2)                       /* 1 = processor clock, 0 = reference */
+
+/* System Control Block registers */
+#define SCB_ICSR        (*(volatile uint32_t*)0xE000ED04)   /* Interrupt Control and State */
+#define SCB_ICSR_PENDSTSET  (1u << 26)                      /* SysTick exception pending */
+#define SCB_VTOR        (*(volatile uint32_t*)0xE000ED08)   /* Vector Table Offset */
+#define SCB_SHPR3       (*(volatile uint32_t*)0xE000ED20)   /* System Handler Priority (PendSV, SysTick) */
+#define SCB_SHCSR       (*(volatile uint32_t*)0xE000ED24)   /* System Handler Control and State */
+#define SCB_SHCSR_MEMFAULTENA (1u << 16)                    /* MemManage exception enable */
+#define SCB_CFSR        (*(volatile uint32_t*)0xE000ED28)   /* Configurable Fault Status */
+#define SCB_CFSR_MSTKERR    (1u << 4)                       /* MemManage fault on exception entry stacking */
+#define SCB_CFSR_MMARVALID  (1u << 7)                       /* SCB_MMFAR holds the faulting address */
+#define SCB_MMFAR       (*(volatile uint32_t*)0xE000ED34)   /* MemManage Fault Address */
+#define SCB_CPACR       (*(volatile uint32_t*)0xE000ED88)   /* Coprocessor Access Control */
+#define SCB_CPACR_CP10_CP11 (0xFu << 20)                    /* Full access to the FPU (CP10, CP11) */
+
+/* Floating-point context control */
+#define FPU_FPCCR       (*(volatile uint32_t*)0xE000EF34)   /* FP Context Control */
+#define FPU_FPCCR_ASPEN (1u << 31)                          /* Stack FP context on exception entry */
+#define FPU_FPCCR_LSPEN (1u << 30)                          /* ... lazily, only if the handler uses FP */
+
+/* Memory Protection Unit (PMSAv8) */
+#define MPU_CTRL        (*(volatile uint32_t*)0xE000ED94)   /* Control */
+#define MPU_RNR         (*(volatile uint32_t*)0xE000ED98)   /* Region Number */
+#define MPU_RBAR        (*(volatile uint32_t*)0xE000ED9C)   /* Region Base Address and access */
+#define MPU_RLAR        (*(volatile uint32_t*)0xE000EDA0)   /* Region Limit Address and attributes */
+#define MPU_MAIR0       (*(volatile uint32_t*)0xE000EDC0)   /* Memory Attribute Indirection 0-3 */
+#define MPU_CTRL_ENABLE     (1u << 0)                       /* MPU enable */
+#define MPU_CTRL_PRIVDEFENA (1u << 2)                       /* Default memory map for privileged code */
+#define MPU_RBAR_XN         (1u << 0)                       /* Execute never */
+#define MPU_RBAR_AP_RO_PRIV (2u << 1)                       /* Read-only, privileged only */
+#define MPU_RLAR_EN         (1u << 0)                       /* Region enable */
+
+/* Debug and trace registers used for cycle counting */
+#define DEMCR           (*(volatile uint32_t*)0xE000EDFC)   /* Debug Exception and Monitor Control */
+#define DEMCR_TRCENA    (1u << 24)                          /* Enable DWT and ITM */
+#define DWT_CTRL        (*(volatile uint32_t*)0xE0001000)   /* DWT Control */
+#define DWT_CYCCNT      (*(volatile uint32_t*)0xE0001004)   /* DWT Cycle Counter */
+#define DWT_CTRL_CYCCNTENA  (1u << 0)                       /* Cycle counter enable */
+
+/* Enable an external interrupt line in the NVIC */
+static inline void nvic_enable_irq(uint32_t irq) {
+    NVIC_ISER(irq >> 5) = 1u << (irq & 31);
+}
+
+/* Disable an external interrupt line in the NVIC */
+static inline void nvic_disable_irq(uint32_t irq) {
+    NVIC_ICER(irq >> 5) = 1u << (irq & 31);
+}
+
+/* Set the priority of an external interrupt (only the top 4 bits are implemented) */
+static inline void nvic_set_priority(uint32_t irq, uint8_t priority) {
+    NVIC_IPR(irq) = priority;
+}
+
+/* Mask interrupts and return the previous PRIMASK value */
+static inline uint32_t irq_save(void) {
+    uint32_t primask;
+    __asm__ volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+/* Restore a PRIMASK value returned by irq_save() */
+static inline void irq_restore(uint32_t primask) {
+    __asm__ volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/* Sleep until an interrupt is pending (wakes even while PRIMASK is set) */
+static inline void cpu_wfi(void) {
+    __asm__ volatile ("wfi" ::: "memory");
+}
+
+/* Complete outstanding memory accesses and refetch the instruction stream */
+static inline void cpu_barrier(void) {
+    __asm__ volatile ("dsb\n\tisb" ::: "memory");
+}
+
+/* Start the free-running DWT cycle counter */
+static inline void dwt_cycle_counter_enable(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/* Current DWT cycle count (wraps every 2^32 cycles) */
+static inline uint32_t dwt_cycles(void) {
+    return DWT_CYCCNT;
+}
+
+#endif /* CORTEX_M33_H */
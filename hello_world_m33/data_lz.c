@@ -0,0 +1,42 @@
+/*
+ * Compressed .data Initializer
+ * Token format (see tools/pack_data.py):
+ *   0lllllll           l+1 literal bytes follow
+ *   10llllll v         byte v repeated l+3 times
+ *   11llllll d0 d1     copy l+4 bytes from (d1:d0)+1 bytes back
+ * Matches may overlap their own output, so they are copied bytewise.
+ */
+
+#include "data_lz.h"
+
+/* Runs from Reset_Handler before .data and .bss exist: keep the copy loops
+ * from being turned into library memcpy()/memset() calls */
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+void data_lz_unpack(const uint8_t* src, uint8_t* dst, uint8_t* end) {
+    while (dst < end) {
+        uint32_t token = *src++;
+        uint32_t len;
+
+        if (token < 0x80) {
+            len = token + 1;
+            while (len--) {
+                *dst++ = *src++;
+            }
+        } else if (token < 0xC0) {
+            uint8_t value = *src++;
+
+            len = (token & 0x3F) + 3;
+            while (len--) {
+                *dst++ = value;
+            }
+        } else {
+            const uint8_t* from = dst - ((uint32_t)src[0] | ((uint32_t)src[1] << 8)) - 1;
+
+            src += 2;
+            len = (token & 0x3F) + 4;
+            while (len--) {
+                *dst++ = *from++;
+            }
+        }
+    }
+}
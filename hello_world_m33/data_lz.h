@@ -0,0 +1,19 @@
+/*
+ * Compressed .data Initializer
+ * With "make COMPRESS_DATA=1" the flash copy of .data is replaced by a
+ * stream from tools/pack_data.py (literal runs, byte fills and 16-bit
+ * window back-references) that Reset_Handler expands into SRAM instead of
+ * copying. Without it the .data_lz section is empty and .data is copied
+ * verbatim.
+ */
+
+#ifndef DATA_LZ_H
+#define DATA_LZ_H
+
+#include <stdint.h>
+
+/* Expand the stream at src into [dst, end). Called from Reset_Handler
+ * before .data and .bss exist, so it touches neither. */
+void data_lz_unpack(const uint8_t* src, uint8_t* dst, uint8_t* end);
+
+#endif /* DATA_LZ_H */
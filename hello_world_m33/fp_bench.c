@@ -0,0 +1,142 @@
+/*
+ * Floating-Point Benchmark
+ * The checksums must match between the soft and hard builds; the cycle
+ * counts show the cost of emulating each operation in libgcc.
+ */
+
+#include "fp_bench.h"
+#include "uart_printf.h"
+#include "cortex_m33.h"
+
+#define FP_SAMPLES      256
+#define FP_FIR_TAPS     16
+#define FP_MAT_N        4
+#define FP_MAT_ROUNDS   64
+
+static float fp_input[FP_SAMPLES];
+static float fp_output[FP_SAMPLES];
+static float fp_taps[FP_FIR_TAPS];
+
+/* Triangle wave in [-1, 1] and a windowed low-pass-like tap set */
+static void fp_bench_setup(void) {
+    for (uint32_t i = 0; i < FP_SAMPLES; i++) {
+        uint32_t phase = i % 64;
+        fp_input[i] = (phase < 32 ? (float)phase : (float)(64 - phase)) / 16.0f - 1.0f;
+    }
+    for (uint32_t i = 0; i < FP_FIR_TAPS; i++) {
+        float x = (float)i - (FP_FIR_TAPS - 1) / 2.0f;
+        fp_taps[i] = 1.0f / (1.0f + x * x);
+    }
+}
+
+/* Second-order IIR section (direct form I), 2nd-order Butterworth low-pass */
+__attribute__((noinline))
+static float fp_biquad(const float* in, float* out, uint32_t n) {
+    const float b0 = 0.0675f, b1 = 0.1349f, b2 = 0.0675f;
+    const float a1 = -1.1430f, a2 = 0.4128f;
+    float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+    float sum = 0.0f;
+
+    for (uint32_t i = 0; i < n; i++) {
+        float y = b0 * in[i] + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = in[i];
+        y2 = y1;
+        y1 = y;
+        out[i] = y;
+        sum += y;
+    }
+    return sum;
+}
+
+/* Direct-form FIR over the input, treating samples before 0 as zero */
+__attribute__((noinline))
+static float fp_fir(const float* in, float* out, uint32_t n) {
+    float sum = 0.0f;
+
+    for (uint32_t i = 0; i < n; i++) {
+        float acc = 0.0f;
+        for (uint32_t k = 0; k < FP_FIR_TAPS && k <= i; k++) {
+            acc += fp_taps[k] * in[i - k];
+        }
+        out[i] = acc;
+        sum += acc;
+    }
+    return sum;
+}
+
+/* Repeated 4x4 matrix product m = m * r, renormalized to stay bounded */
+__attribute__((noinline))
+static float fp_matrix(uint32_t rounds) {
+    float m[FP_MAT_N][FP_MAT_N];
+    float r[FP_MAT_N][FP_MAT_N];
+    float t[FP_MAT_N][FP_MAT_N];
+    float trace = 0.0f;
+
+    for (uint32_t i = 0; i < FP_MAT_N; i++) {
+        for (uint32_t j = 0; j < FP_MAT_N; j++) {
+            m[i][j] = i == j ? 1.0f : 0.0f;
+            r[i][j] = fp_input[(i * FP_MAT_N + j) * 7] * 0.5f + (i == j ? 0.5f : 0.0f);
+        }
+    }
+
+    while (rounds--) {
+        float norm = 0.0f;
+
+        for (uint32_t i = 0; i < FP_MAT_N; i++) {
+            for (uint32_t j = 0; j < FP_MAT_N; j++) {
+                float acc = 0.0f;
+                for (uint32_t k = 0; k < FP_MAT_N; k++) {
+                    acc += m[i][k] * r[k][j];
+                }
+                t[i][j] = acc;
+                norm += acc < 0.0f ? -acc : acc;
+            }
+        }
+        norm = FP_MAT_N / norm;
+        for (uint32_t i = 0; i < FP_MAT_N; i++) {
+            for (uint32_t j = 0; j < FP_MAT_N; j++) {
+                m[i][j] = t[i][j] * norm;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < FP_MAT_N; i++) {
+        trace += m[i][i];
+    }
+    return trace;
+}
+
+/* Result in thousandths, printed with %.3k */
+static int32_t fp_milli(float value) {
+    return (int32_t)(value * 1000.0f);
+}
+
+void fp_bench(void) {
+    uint32_t start;
+    uint32_t cycles[3];
+    float result[3];
+
+    fp_bench_setup();
+
+    start = dwt_cycles();
+    result[0] = fp_biquad(fp_input, fp_output, FP_SAMPLES);
+    cycles[0] = dwt_cycles() - start;
+
+    start = dwt_cycles();
+    result[1] = fp_fir(fp_input, fp_output, FP_SAMPLES);
+    cycles[1] = dwt_cycles() - start;
+
+    start = dwt_cycles();
+    result[2] = fp_matrix(FP_MAT_ROUNDS);
+    cycles[2] = dwt_cycles() - start;
+
+#if defined(__ARM_FP)
+    uart_printf("fp bench (hard float, FPU), DWT cycles:\n");
+#else
+    uart_printf("fp bench (soft float, libgcc), DWT cycles:\n");
+#endif
+    uart_printf("fp   biquad %3u samples   %8u  result %.3k\n", FP_SAMPLES, cycles[0], fp_milli(result[0]));
+    uart_printf("fp   fir%u  %4u samples   %8u  result %.3k\n", FP_FIR_TAPS, FP_SAMPLES, cycles[1], fp_milli(result[1]));
+    uart_printf("fp   mat4x4 %3u products  %8u  result %.3k\n", FP_MAT_ROUNDS, cycles[2], fp_milli(result[2]));
+}
@@ -0,0 +1,15 @@
+/*
+ * Floating-Point Benchmark
+ * Single-precision filter and matrix kernels timed in DWT cycles. Run the
+ * same source in both build variants ("make fp-bench", or build with
+ * FLOAT_ABI=soft / FLOAT_ABI=hard and DEFINES=-DFP_BENCH) to compare
+ * libgcc soft-float calls with FPU instructions.
+ */
+
+#ifndef FP_BENCH_H
+#define FP_BENCH_H
+
+/* Run every kernel and print cycles and a result checksum */
+void fp_bench(void);
+
+#endif /* FP_BENCH_H */
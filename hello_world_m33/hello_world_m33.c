@@ -5,148 +5,281 @@
  */
 
 #include <stdint.h>
+#include "uart_pl011.h"
+#include "uart_printf.h"
+#include "numfmt.h"
+#include "log_tok.h"
+#include "systick.h"
+#include "profile.h"
+#include "cmd.h"
+#include "uart_dma.h"
+#include "ramfunc.h"
+#include "stack.h"
+#include "stack_guard.h"
+#include "arena.h"
+#include "pool.h"
+#include "fp_bench.h"
+#include "pgo.h"
 
-/* ARM PL011 UART Register Definitions */
-#define UART_BASE       0x40000000
-
-#define UART_DR         (*(volatile uint32_t*)(UART_BASE + 0x00))   /* Data Register */
-#define UART_FR         (*(volatile uint32_t*)(UART_BASE + 0x18))   /* Flag Register */
-#define UART_IBRD       (*(volatile uint32_t*)(UART_BASE + 0x24))   /* Integer Baud Rate */
-#define UART_FBRD       (*(volatile uint32_t*)(UART_BASE + 0x28))   /* Fractional Baud Rate */
-#define UART_LCRH       (*(volatile uint32_t*)(UART_BASE + 0x2C))   /* Line Control */
-#define UART_CR         (*(volatile uint32_t*)(UART_BASE + 0x30))   /* Control Register */
-#define UART_IMSC       (*(volatile uint32_t*)(UART_BASE + 0x38))   /* Interrupt Mask */
-
-/* UART Flag Register bits */
-#define UART_FR_TXFF    (1 << 5)    /* Transmit FIFO Full */
-#define UART_FR_BUSY    (1 << 3)    /* UART Busy */
-
-/* UART Control Register bits */
-#define UART_CR_UARTEN  (1 << 0)    /* UART Enable */
-#define UART_CR_TXE     (1 << 8)    /* Transmit Enable */
-#define UART_CR_RXE     (1 << 9)    /* Receive Enable */
-
-/* UART Line Control Register bits */
-#define UART_LCRH_WLEN8 (3 << 5)    /* 8-bit word length */
-#define UART_LCRH_FEN   (1 << 4)    /* FIFO Enable */
-
-/* Simple delay function (not precise timing) */
-static void delay(volatile uint32_t count) {
-    while (count--) {
-        __asm__ volatile ("nop");
+/* Section boundaries from linker_m33.ld, reported with the boot time */
+extern char _sdata[], _edata[], _sbss[], _ebss[];
+
+/* Function prototype for SystemInit */
+void SystemInit(void);
+
+/* System initialization function (called from startup) */
+void SystemInit(void) {
+    /* Start the DWT cycle counter used by the profiling layer. This runs
+     * before .data/.bss are initialized, so only registers are touched. */
+    dwt_cycle_counter_enable();
+
+    /* Fault on the first store below the stack instead of corrupting the heap */
+    stack_guard_init();
+
+#if defined(__ARM_FP)
+    /* Hard-float build: grant access to the FPU before any FP instruction,
+     * and stack FP registers on exception entry only when a handler
+     * actually touches the FPU (lazy stacking) */
+    SCB_CPACR |= SCB_CPACR_CP10_CP11;
+    FPU_FPCCR |= FPU_FPCCR_ASPEN | FPU_FPCCR_LSPEN;
+    cpu_barrier();
+#endif
+}
+
+/* Message buffers: fixed blocks carved from the heap at startup */
+#define MSG_BLOCK_SIZE      64
+#define MSG_BLOCK_COUNT     16
+
+static arena_t heap;
+static pool_t msg_pool;
+static int msg_pool_ready;
+
+/* Demo state, shared with the command handlers below */
+static uint32_t counter;
+static uint32_t period_ms = 1000;
+static uint32_t next_ms;
+
+static void cmd_do_help(const char* args) {
+    uart_puts("Commands:\n");
+    cmd_help();
+}
+
+static void cmd_do_stats(const char* args) {
+    /* Copy the pool first: interrupts may change its counters while the
+     * report prints. The copy is command scratch, released by the main
+     * loop's arena scope once the command returns. */
+    pool_t* pool = arena_alloc(&heap, sizeof(*pool), 4);
+
+    if (pool) {
+        *pool = msg_pool;
+    }
+    uart_printf("uptime %u ms, counter %u, period %u ms, rx overruns %u\n",
+                systick_ms(), counter, period_ms, uart_rx_overruns());
+    stack_report();
+    arena_report(&heap);
+    if (msg_pool_ready) {
+        pool_report(pool ? pool : &msg_pool);
     }
+    profile_dump();
 }
 
-/* Initialize the UART for communication */
-static void uart_init(void) {
-    /* Disable UART during configuration */
-    UART_CR = 0;
-    
-    /* Set baud rate to 115200 (assuming 24MHz clock) */
-    /* Baud rate calculation: baud_div = clock_freq / (16 * baud_rate) */
-    /* For 24MHz / (16 * 115200) = 13.02 */
-    UART_IBRD = 13;      /* Integer part */
-    UART_FBRD = 1;       /* Fractional part (approximate) */
-    
-    /* Configure: 8 data bits, no parity, 1 stop bit, FIFO enabled */
-    UART_LCRH = UART_LCRH_WLEN8 | UART_LCRH_FEN;
-    
-    /* Disable interrupts for this simple demo */
-    UART_IMSC = 0;
-    
-    /* Enable UART, transmit, and receive */
-    UART_CR = UART_CR_UARTEN | UART_CR_TXE | UART_CR_RXE;
-    
-    /* Small delay to ensure UART is ready */
-    delay(1000);
+static void cmd_do_reset_counter(const char* args) {
+    counter = 0;
+    uart_puts("counter reset\n");
 }
 
-/* Send a single character via UART */
-static void uart_putchar(char c) {
-    /* Wait until transmit FIFO is not full */
-    while (UART_FR & UART_FR_TXFF) {
-        /* Wait */
+static void cmd_do_set_rate(const char* args) {
+    uint32_t ms;
+
+    if (cmd_parse_u32(args, &ms) != 0 || ms == 0 || ms > 60000) {
+        uart_puts("usage: set rate <1..60000 ms>\n");
+        return;
     }
-    
-    /* Send the character */
-    UART_DR = c;
+    period_ms = ms;
+    next_ms = systick_ms() + ms;
+    uart_printf("message period %u ms\n", ms);
 }
 
-/* Send a string via UART */
-static void uart_puts(const char* str) {
-    while (*str) {
-        /* Convert line feeds to carriage return + line feed */
-        if (*str == '\n') {
-            uart_putchar('\r');
-        }
-        uart_putchar(*str++);
+/* Recurse until the MPU stack guard stops it. Every word of each frame is
+ * written, lowest first, so the first frame that reaches the guard faults. */
+__attribute__((noinline))
+static uint32_t overflow_recurse(uint32_t depth) {
+    volatile uint32_t frame[16];
+
+    for (uint32_t i = 0; i < 16; i++) {
+        frame[i] = depth + i;
     }
+    if (depth == UINT32_MAX) {
+        return 0;
+    }
+    return overflow_recurse(depth + 1) + frame[0];
 }
 
-/* Send a number as decimal via UART */
-static void uart_put_number(uint32_t num) {
-    char buffer[12];  /* Enough for 32-bit number */
-    char* ptr = buffer + sizeof(buffer) - 1;
-    
-    *ptr = '\0';  /* Null terminator */
-    
-    if (num == 0) {
-        *(--ptr) = '0';
-    } else {
-        while (num > 0) {
-            *(--ptr) = '0' + (num % 10);
-            num /= 10;
-        }
+static void cmd_do_stack_overflow(const char* args) {
+    uart_puts("overflowing the stack...\n");
+    uart_flush();
+    uart_printf("not reached (%u)\n", overflow_recurse(0));
+}
+
+static void cmd_do_set_baud(const char* args) {
+    uint32_t baud;
+
+    if (cmd_parse_u32(args, &baud) != 0) {
+        uart_printf("usage: set baud <rate> (e.g. %u; at most %u)\n",
+                    UART_BAUD_TELEMETRY, PL011_BAUD_MAX(BOARD_CLOCK_UART_HZ));
+        return;
     }
-    
-    uart_puts(ptr);
+    if (!PL011_BAUD_OK(BOARD_CLOCK_UART_HZ, baud)) {
+        uart_printf("%u baud is not reachable from the %u Hz UART clock (at most %u)\n",
+                    baud, BOARD_CLOCK_UART_HZ, PL011_BAUD_MAX(BOARD_CLOCK_UART_HZ));
+        return;
+    }
+    uart_printf("switching to %u baud\n", baud);
+    uart_set_baud(baud);
+    uart_printf("UART at %u baud (divisor gives %u)\n", uart_baud(), uart_baud_actual());
 }
 
-/* Function prototype for SystemInit */
-void SystemInit(void);
+/* At most 9 + NUMFMT_U32_MAX + 26 = 45 bytes, within MSG_BLOCK_SIZE */
+#define MSG_COUNTER_HEAD    "Counter: "
+#define MSG_COUNTER_TAIL    " - Cortex-M33 is running!\n"
 
-/* System initialization function (called from startup) */
-void SystemInit(void) {
-    /* For this simple demo, we don't need complex system initialization */
-    /* In a real application, you might configure clocks, caches, etc. */
+#ifndef LOG_DEFERRED
+/* Append the len bytes at src to dst and return the new end */
+static char* msg_append(char* dst, const char* src, uint32_t len) {
+    while (len--) {
+        *dst++ = *src++;
+    }
+    return dst;
+}
+
+/* Build the counter line in a block from msg_pool and queue it. The UART
+ * copies it into its transmit ring, so the block is free again at once. */
+static void send_counter_line(void) {
+    char* msg = msg_pool_ready ? pool_alloc(&msg_pool) : 0;
+    char* p;
+
+    if (!msg) {
+        LOG(MSG_COUNTER_HEAD "%u" MSG_COUNTER_TAIL, counter);
+        return;
+    }
+    p = msg_append(msg, MSG_COUNTER_HEAD, sizeof(MSG_COUNTER_HEAD) - 1);
+    p += numfmt_u32(p, counter);
+    p = msg_append(p, MSG_COUNTER_TAIL, sizeof(MSG_COUNTER_TAIL) - 1);
+    uart_queue_text(msg, (uint32_t)(p - msg));
+    uart_tx_start();
+    pool_free(&msg_pool, msg);
 }
+#endif /* LOG_DEFERRED */
+
+static const cmd_t commands[] = {
+    { "help",           "",                 cmd_do_help },
+    { "stats",          "",                 cmd_do_stats },
+    { "reset counter",  "",                 cmd_do_reset_counter },
+    { "set rate",       "<ms>",             cmd_do_set_rate },
+    { "set baud",       "<rate>",           cmd_do_set_baud },
+    { "stack overflow", "(halts: tests the MPU guard)", cmd_do_stack_overflow },
+};
 
 /* Main application function */
 int main(void) {
-    uint32_t counter = 0;
-    
-    /* Initialize the UART for output */
+    /* Cycles from the start of the counter in SystemInit() to here, i.e.
+     * the .data copy and .bss clear of Reset_Handler */
+    uint32_t boot_cycles = dwt_cycles();
+
+    PROFILE_SAMPLE(boot_to_main, boot_cycles);
+    profile_init();
+
+    /* Initialize the UART for output and the 1 ms timebase */
     uart_init();
+    uart_dma_init();
+    systick_init();
+
+    /* Heap arena over _heap_start.._heap_end and the message pool inside it */
+    arena_init_heap(&heap);
+    msg_pool_ready = pool_init(&msg_pool, "msg",
+                               arena_alloc(&heap, POOL_BYTES(MSG_BLOCK_SIZE, MSG_BLOCK_COUNT),
+                                           POOL_ALIGN),
+                               MSG_BLOCK_SIZE, MSG_BLOCK_COUNT) == 0;
+    if (!msg_pool_ready) {
+        uart_puts("Heap too small for the message pool; counter lines bypass it\n");
+    }
     
     /* Send startup message */
     uart_puts("===========================================\n");
     uart_puts("ARM Cortex-M33 Custom Board Demo\n");
     uart_puts("===========================================\n");
     uart_puts("Board: Custom ARM Cortex-M33 Board (Renode)\n");
-    uart_puts("CPU: ARM Cortex-M33 @ 100MHz\n");
+    uart_printf("CPU: ARM Cortex-M33 @ %uMHz\n", BOARD_CLOCK_CPU_HZ / 1000000u);
     uart_puts("Memory: 1MB Flash + 256KB SRAM\n");
-    uart_puts("UART: PL011 @ 115200 baud\n");
-    uart_puts("===========================================\n\n");
+    uart_printf("UART: PL011 @ %u baud (%uMHz UART clock)\n",
+                uart_baud(), BOARD_CLOCK_UART_HZ / 1000000u);
+    uart_puts("===========================================\n");
+    uart_printf("Boot: %u cycles from reset to main() (.data %u bytes, .bss %u bytes)\n\n",
+                boot_cycles, (uint32_t)(_edata - _sdata), (uint32_t)(_ebss - _sbss));
     
     uart_puts("Starting counter demonstration...\n");
     uart_puts("This demonstrates basic UART communication\n");
-    uart_puts("and timing on a custom ARM Cortex-M33 board.\n\n");
+    uart_puts("and timing on a custom ARM Cortex-M33 board.\n");
+    uart_puts("Type \"help\" for commands.\n\n");
+    cmd_init(commands, sizeof(commands) / sizeof(commands[0]));
+
+#ifdef NUMFMT_BENCH
+    numfmt_bench();
+#endif
+#ifdef UART_DMA_BENCH
+    uart_dma_bench();
+#endif
+#ifdef RAMFUNC_BENCH
+    ramfunc_bench();
+#endif
+#ifdef FP_BENCH
+    fp_bench();
+#endif
     
-    /* Main application loop */
+    /* Main application loop: one message per period on an absolute
+     * schedule; in between the core sleeps in WFI until the next message
+     * is due or a received character wakes it to run commands */
+    next_ms = systick_ms();
     while (1) {
-        uart_puts("Counter: ");
-        uart_put_number(counter);
-        uart_puts(" - Cortex-M33 is running!\n");
+        /* Commands may take scratch from the heap; it is released on return */
+        arena_mark_t scope = arena_mark(&heap);
+
+        cmd_poll();
+        arena_release(&heap, scope);
+
+        if ((int32_t)(systick_ms() - next_ms) < 0) {
+#ifdef BUSY_DELAY
+            /* Baseline for tools/sim_speed.sh: spin on nops like the
+             * original delay() loop, so the core never idles */
+            __asm__ volatile ("nop");
+#else
+            systick_idle_until_ms(next_ms, uart_rx_available);
+#endif
+            continue;
+        }
+
+        PROFILE_BEGIN(log_line);
+#ifdef LOG_DEFERRED
+        /* A token frame needs no text buffer */
+        LOG(MSG_COUNTER_HEAD "%u" MSG_COUNTER_TAIL, counter);
+#else
+        send_counter_line();
+#endif
+        PROFILE_END(log_line);
         
         counter++;
-        
-        /* Add a delay between messages */
-        delay(2000000);  /* Approximate 1 second delay */
+        next_ms += period_ms;
         
         /* Reset counter after reaching 100 for cleaner demo */
         if (counter > 100) {
             counter = 0;
-            uart_puts("\n--- Counter reset ---\n\n");
+            LOG("\n--- Counter reset ---\n\n");
+            stack_report();
+            profile_dump();
+#ifdef PGO_GENERATE
+            /* One full counter cycle is the training workload */
+            pgo_dump();
+#endif
         }
     }
     
@@ -0,0 +1,57 @@
+/*
+ * Run-Time Interrupt Handler Registration
+ * Only a pointer store separates registration from the next interrupt, so
+ * both the relocation and every update are followed by a barrier.
+ */
+
+#include "irq.h"
+#include "cortex_m33.h"
+
+#if IRQ_VECTOR_COUNT * 4 > 256
+#error "IRQ_VECTOR_COUNT needs a larger .ram_vectors alignment in linker_m33.ld"
+#endif
+
+/* Flash vector table and its default handler (startup_m33.S) */
+extern const irq_handler_t g_pfnVectors[];
+extern const irq_handler_t g_pfnVectors_end[];
+void Default_Handler(void);
+
+/* VTOR requires alignment to the table size rounded up to a power of two */
+static irq_handler_t irq_ram_vectors[IRQ_VECTOR_COUNT]
+    __attribute__((section(".ram_vectors"), aligned(256)));
+
+void irq_vectors_to_sram(void) {
+    uint32_t primask = irq_save();
+
+    if (SCB_VTOR != (uint32_t)irq_ram_vectors) {
+        uint32_t flash_count = (uint32_t)(g_pfnVectors_end - g_pfnVectors);
+        uint32_t i;
+
+        for (i = 0; i < IRQ_VECTOR_COUNT && i < flash_count; i++) {
+            irq_ram_vectors[i] = g_pfnVectors[i];
+        }
+        for (; i < IRQ_VECTOR_COUNT; i++) {
+            irq_ram_vectors[i] = Default_Handler;
+        }
+
+        cpu_barrier();
+        SCB_VTOR = (uint32_t)irq_ram_vectors;
+        cpu_barrier();
+    }
+
+    irq_restore(primask);
+}
+
+int irq_register(int32_t irqn, irq_handler_t handler) {
+    int32_t index = irqn + 16;
+
+    /* Slots 0 and 1 hold the initial SP and the reset vector */
+    if (index < 2 || index >= IRQ_VECTOR_COUNT || handler == 0) {
+        return -1;
+    }
+
+    irq_vectors_to_sram();
+    irq_ram_vectors[index] = handler;
+    cpu_barrier();
+    return 0;
+}
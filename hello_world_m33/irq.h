@@ -0,0 +1,33 @@
+/*
+ * Run-Time Interrupt Handler Registration
+ * The flash vector table in startup_m33.S is fixed at link time. The first
+ * irq_register() copies it into an aligned table in SRAM (.ram_vectors in
+ * linker_m33.ld) and points VTOR there; from then on handlers are written
+ * straight into the vector slots, so an installed driver is entered by the
+ * hardware without a dispatch trampoline. Images that never register a
+ * handler keep running from the flash table.
+ */
+
+#ifndef IRQ_H
+#define IRQ_H
+
+#include <stdint.h>
+
+/* External interrupt lines covered by the SRAM table */
+#define IRQ_LINES           32
+
+/* System exceptions plus external lines; the table is aligned to 256 bytes */
+#define IRQ_VECTOR_COUNT    (16 + IRQ_LINES)
+
+typedef void (*irq_handler_t)(void);
+
+/* Copy the flash vector table to SRAM and switch VTOR to it (idempotent).
+ * Slots past the end of the flash table are filled with Default_Handler. */
+void irq_vectors_to_sram(void);
+
+/* Install handler for NVIC line irqn, or for a system exception using the
+ * CMSIS numbering (-1 SysTick, -2 PendSV, -5 SVCall, ... -14 NMI).
+ * Relocates the table on first use. Returns 0, or -1 if irqn is out of range. */
+int irq_register(int32_t irqn, irq_handler_t handler);
+
+#endif /* IRQ_H */
@@ -0,0 +1,38 @@
+/*
+ * Tokenized (Deferred) Logging
+ * Frames are built on the stack and handed to the UART in one burst.
+ * Values are LEB128 varints, so small IDs and counters cost one byte.
+ */
+
+#include <stdarg.h>
+#include "log_tok.h"
+#include "uart_pl011.h"
+
+/* Worst-case payload: ID plus LOG_MAX_ARGS arguments, 5 bytes each */
+#define LOG_PAYLOAD_MAX     (5 * (1 + LOG_MAX_ARGS))
+
+/* Append value as an unsigned LEB128 varint */
+static uint8_t* log_put_varint(uint8_t* p, uint32_t value) {
+    while (value >= 0x80) {
+        *p++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+void log_tok_emit(uint32_t id, uint32_t nargs, ...) {
+    uint8_t frame[2 + LOG_PAYLOAD_MAX];
+    uint8_t* p = log_put_varint(&frame[2], id);
+    va_list ap;
+
+    va_start(ap, nargs);
+    while (nargs--) {
+        p = log_put_varint(p, va_arg(ap, uint32_t));
+    }
+    va_end(ap);
+
+    frame[0] = LOG_FRAME_MARKER;
+    frame[1] = (uint8_t)(p - &frame[2]);
+    uart_write(frame, (uint32_t)(p - frame));
+}
@@ -0,0 +1,57 @@
+/*
+ * Tokenized (Deferred) Logging
+ * LOG(fmt, ...) formats on the target with uart_printf() by default.
+ * Built with -DLOG_DEFERRED, the format string is moved into the
+ * non-loaded .log_strings ELF section and only its ID plus the raw
+ * arguments are sent; tools/log_decode.py rebuilds the text on the host
+ * from hello_world_m33.elf.
+ *
+ * Deferred-mode restrictions:
+ *   - at most LOG_MAX_ARGS arguments, each passed as a 32-bit value
+ *   - %s arguments must point into flash (the decoder reads them from the ELF)
+ */
+
+#ifndef LOG_TOK_H
+#define LOG_TOK_H
+
+#include <stdint.h>
+
+#define LOG_MAX_ARGS        7
+
+/* Frame marker: 0x1E (ASCII record separator), length, payload.
+ * Plain text may be interleaved with frames on the same UART. */
+#define LOG_FRAME_MARKER    0x1E
+
+/* Emit one token frame: varint ID followed by nargs varint arguments */
+void log_tok_emit(uint32_t id, uint32_t nargs, ...);
+
+/* Number of arguments after the format string (0 to LOG_MAX_ARGS) */
+#define LOG_ARGC_(...)  LOG_ARGC_N_(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define LOG_ARGC_N_(fmt, a1, a2, a3, a4, a5, a6, a7, n, ...) n
+
+/* Split the format string from its arguments; the trailing 0 keeps the
+ * variadic part non-empty as C99 requires and is never read */
+#define LOG_FMT_(fmt, ...)  fmt
+#define LOG_ARGS_(fmt, ...) __VA_ARGS__
+
+#ifdef LOG_DEFERRED
+
+/* The string's offset in .log_strings is its ID (the section has VMA 0) */
+#define LOG(...)                                                            \
+    do {                                                                    \
+        static const char log_fmt_[]                                        \
+            __attribute__((section(".log_strings"), used)) =                \
+            LOG_FMT_(__VA_ARGS__, 0);                                       \
+        log_tok_emit((uint32_t)(uintptr_t)log_fmt_, LOG_ARGC_(__VA_ARGS__), \
+                     LOG_ARGS_(__VA_ARGS__, 0));                            \
+    } while (0)
+
+#else
+
+#include "uart_printf.h"
+
+#define LOG(...)        uart_printf(__VA_ARGS__)
+
+#endif /* LOG_DEFERRED */
+
+#endif /* LOG_TOK_H */
@@ -0,0 +1,173 @@
+/*
+ * Division-Free Number Formatting
+ * The digit count is found first with a comparison ladder, then digit
+ * pairs are written from the end of the field backwards. Quotients by
+ * 10, 100 and 10^8 use multiply-high reciprocals that are exact over the
+ * whole input range, so neither UDIV nor the libgcc 64-bit divide runs.
+ */
+
+#include "numfmt.h"
+
+/* "00" "01" ... "99": two output characters per table lookup */
+static const char numfmt_pairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+const char numfmt_hex_lower[16] = "0123456789abcdef";
+const char numfmt_hex_upper[16] = "0123456789ABCDEF";
+
+/* x / 10 for any 32-bit x: (x * ceil(2^35 / 10)) >> 35 */
+static inline uint32_t numfmt_div10(uint32_t x) {
+    return (uint32_t)(((uint64_t)x * 0xCCCCCCCDu) >> 35);
+}
+
+/* x / 100 for any 32-bit x: (x * ceil(2^37 / 100)) >> 37 */
+static inline uint32_t numfmt_div100(uint32_t x) {
+    return (uint32_t)(((uint64_t)x * 0x51EB851Fu) >> 37);
+}
+
+/* High 64 bits of a 64x64-bit product, built from four 32x32 UMULLs */
+static inline uint64_t numfmt_mulhi64(uint64_t a, uint64_t b) {
+    uint64_t a_lo = (uint32_t)a;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b;
+    uint64_t b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t mid = (lo_lo >> 32) + (uint32_t)lo_hi + (uint32_t)hi_lo;
+
+    return a_hi * b_hi + (lo_hi >> 32) + (hi_lo >> 32) + (mid >> 32);
+}
+
+/* x / 10^8 for any 64-bit x: mulhi(x, ceil(2^90 / 10^8)) >> 26 */
+static inline uint64_t numfmt_div1e8(uint64_t x) {
+    return numfmt_mulhi64(x, 0xABCC77118461CEFDull) >> 26;
+}
+
+/* Number of decimal digits in value (1 for zero) */
+static inline uint32_t numfmt_digits_u32(uint32_t value) {
+    if (value < 100000) {
+        if (value < 100) {
+            return value < 10 ? 1 : 2;
+        }
+        if (value < 10000) {
+            return value < 1000 ? 3 : 4;
+        }
+        return 5;
+    }
+    if (value < 10000000) {
+        return value < 1000000 ? 6 : 7;
+    }
+    if (value < 1000000000) {
+        return value < 100000000 ? 8 : 9;
+    }
+    return 10;
+}
+
+/* Write value as exactly len digits ending at end (leading zeros kept) */
+static inline void numfmt_write_digits(char* end, uint32_t value, uint32_t len) {
+    while (len >= 2) {
+        uint32_t q = numfmt_div100(value);
+        const char* pair = &numfmt_pairs[(value - q * 100) * 2];
+
+        end -= 2;
+        end[0] = pair[0];
+        end[1] = pair[1];
+        value = q;
+        len -= 2;
+    }
+    if (len) {
+        *--end = (char)('0' + (value - numfmt_div10(value) * 10));
+    }
+}
+
+uint32_t numfmt_u32(char* buf, uint32_t value) {
+    uint32_t len = numfmt_digits_u32(value);
+
+    numfmt_write_digits(buf + len, value, len);
+    return len;
+}
+
+uint32_t numfmt_i32(char* buf, int32_t value) {
+    if (value < 0) {
+        *buf = '-';
+        return 1 + numfmt_u32(buf + 1, 0u - (uint32_t)value);
+    }
+    return numfmt_u32(buf, (uint32_t)value);
+}
+
+uint32_t numfmt_u64(char* buf, uint64_t value) {
+    uint32_t low;
+    uint32_t mid;
+    uint64_t q;
+    uint32_t len;
+
+    if ((value >> 32) == 0) {
+        return numfmt_u32(buf, (uint32_t)value);
+    }
+
+    /* Split into <= 4 leading digits and two 8-digit chunks */
+    q = numfmt_div1e8(value);
+    low = (uint32_t)(value - q * 100000000u);
+    if ((q >> 32) == 0) {
+        len = numfmt_u32(buf, (uint32_t)q);
+    } else {
+        uint64_t top = numfmt_div1e8(q);
+        mid = (uint32_t)(q - top * 100000000u);
+        len = numfmt_u32(buf, (uint32_t)top);
+        numfmt_write_digits(buf + len + 8, mid, 8);
+        len += 8;
+    }
+    numfmt_write_digits(buf + len + 8, low, 8);
+    return len + 8;
+}
+
+uint32_t numfmt_i64(char* buf, int64_t value) {
+    if (value < 0) {
+        *buf = '-';
+        return 1 + numfmt_u64(buf + 1, 0u - (uint64_t)value);
+    }
+    return numfmt_u64(buf, (uint64_t)value);
+}
+
+uint32_t numfmt_hex32(char* buf, uint32_t value, const char* digits) {
+    uint32_t len = (32 - (uint32_t)__builtin_clz(value | 1) + 3) >> 2;
+    char* p = buf + len;
+
+    do {
+        *--p = digits[value & 0xF];
+        value >>= 4;
+    } while (p != buf);
+    return len;
+}
+
+uint32_t numfmt_ufixed32(char* buf, uint32_t value, uint32_t frac_digits) {
+    uint32_t len = numfmt_digits_u32(value);
+    uint32_t int_digits;
+    uint32_t i;
+
+    if (frac_digits == 0) {
+        numfmt_write_digits(buf + len, value, len);
+        return len;
+    }
+
+    /* At least one integer digit: 5 with 3 fractional digits is "0.005" */
+    int_digits = len > frac_digits ? len - frac_digits : 1;
+    numfmt_write_digits(buf + int_digits + 1 + frac_digits, value, frac_digits);
+    buf[int_digits] = '.';
+    for (i = 0; i < frac_digits; i++) {
+        value = numfmt_div10(value);
+    }
+    numfmt_write_digits(buf + int_digits, value, int_digits);
+    return int_digits + 1 + frac_digits;
+}
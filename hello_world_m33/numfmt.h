@@ -0,0 +1,42 @@
+/*
+ * Division-Free Number Formatting
+ * Decimal and hexadecimal conversion for the telemetry output path.
+ * Decimal digits are produced two at a time from a 200-byte lookup
+ * table, and every division by a constant is a reciprocal multiply.
+ */
+
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <stdint.h>
+
+/* Buffer sizes needed by each conversion (no NUL terminator is written) */
+#define NUMFMT_U32_MAX      10
+#define NUMFMT_I32_MAX      11
+#define NUMFMT_U64_MAX      20
+#define NUMFMT_I64_MAX      20
+#define NUMFMT_HEX32_MAX    8
+#define NUMFMT_FIXED_MAX    11
+
+/*
+ * Each function writes the digits to the start of buf and returns the
+ * number of characters written.
+ */
+uint32_t numfmt_u32(char* buf, uint32_t value);
+uint32_t numfmt_i32(char* buf, int32_t value);
+uint32_t numfmt_u64(char* buf, uint64_t value);
+uint32_t numfmt_i64(char* buf, int64_t value);
+
+/* Hexadecimal without prefix; digits selects "0123456789abcdef" or upper case */
+uint32_t numfmt_hex32(char* buf, uint32_t value, const char* digits);
+
+/* Decimal fixed-point: value / 10^frac_digits with frac_digits <= 9 */
+uint32_t numfmt_ufixed32(char* buf, uint32_t value, uint32_t frac_digits);
+
+extern const char numfmt_hex_lower[16];
+extern const char numfmt_hex_upper[16];
+
+/* Cycle-count comparison against the original per-digit % 10 routine */
+void numfmt_bench(void);
+
+#endif /* NUMFMT_H */
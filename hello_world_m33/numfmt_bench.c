@@ -0,0 +1,119 @@
+/*
+ * Number Formatting Benchmark
+ * Compares the original per-digit "% 10 / 10" conversion used by
+ * uart_put_number() with the numfmt library, in DWT cycles per call.
+ * Build with "make DEFINES=-DNUMFMT_BENCH" to run it at startup.
+ */
+
+#include "numfmt.h"
+#include "uart_printf.h"
+#include "cortex_m33.h"
+
+#define NUMFMT_BENCH_ROUNDS 64
+
+/* Inputs covering every 32-bit digit count */
+static const uint32_t bench_values_u32[] = {
+    0u, 7u, 42u, 512u, 9999u, 12345u, 654321u, 7654321u,
+    87654321u, 987654321u, 2147483647u, 4294967295u,
+};
+
+static const uint64_t bench_values_u64[] = {
+    0ull, 4294967295ull, 4294967296ull, 1234567890123ull,
+    98765432109876543ull, 18446744073709551615ull,
+};
+
+#define BENCH_COUNT(a)  (sizeof(a) / sizeof((a)[0]))
+
+/* Keeps the conversions from being optimized away */
+static volatile uint32_t bench_sink;
+
+/* The original uart_put_number() conversion, rendering into a buffer */
+__attribute__((noinline))
+static uint32_t legacy_u32(char* buf, uint32_t num) {
+    char tmp[NUMFMT_U32_MAX];
+    char* ptr = tmp + sizeof(tmp);
+    uint32_t len;
+
+    if (num == 0) {
+        *(--ptr) = '0';
+    } else {
+        while (num > 0) {
+            *(--ptr) = '0' + (num % 10);
+            num /= 10;
+        }
+    }
+
+    len = (uint32_t)(tmp + sizeof(tmp) - ptr);
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = ptr[i];
+    }
+    return len;
+}
+
+/* The same algorithm on 64-bit values (each step is a libgcc divide) */
+__attribute__((noinline))
+static uint32_t legacy_u64(char* buf, uint64_t num) {
+    char tmp[NUMFMT_U64_MAX];
+    char* ptr = tmp + sizeof(tmp);
+    uint32_t len;
+
+    do {
+        *(--ptr) = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num > 0);
+
+    len = (uint32_t)(tmp + sizeof(tmp) - ptr);
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = ptr[i];
+    }
+    return len;
+}
+
+/* Mean cycles per call of a 32-bit converter over the value table */
+static uint32_t bench_u32(uint32_t (*fn)(char*, uint32_t)) {
+    char buf[NUMFMT_U64_MAX];
+    uint32_t sink = 0;
+    uint32_t start = dwt_cycles();
+
+    for (uint32_t round = 0; round < NUMFMT_BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BENCH_COUNT(bench_values_u32); i++) {
+            sink += fn(buf, bench_values_u32[i]);
+        }
+    }
+
+    bench_sink = sink;
+    return (dwt_cycles() - start) / (NUMFMT_BENCH_ROUNDS * BENCH_COUNT(bench_values_u32));
+}
+
+/* Mean cycles per call of a 64-bit converter over the value table */
+static uint32_t bench_u64(uint32_t (*fn)(char*, uint64_t)) {
+    char buf[NUMFMT_U64_MAX];
+    uint32_t sink = 0;
+    uint32_t start = dwt_cycles();
+
+    for (uint32_t round = 0; round < NUMFMT_BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BENCH_COUNT(bench_values_u64); i++) {
+            sink += fn(buf, bench_values_u64[i]);
+        }
+    }
+
+    bench_sink = sink;
+    return (dwt_cycles() - start) / (NUMFMT_BENCH_ROUNDS * BENCH_COUNT(bench_values_u64));
+}
+
+void numfmt_bench(void) {
+    uint32_t legacy32;
+    uint32_t fast32;
+    uint32_t legacy64;
+    uint32_t fast64;
+
+    legacy32 = bench_u32(legacy_u32);
+    fast32 = bench_u32(numfmt_u32);
+    legacy64 = bench_u64(legacy_u64);
+    fast64 = bench_u64(numfmt_u64);
+
+    uart_printf("numfmt bench (cycles/call, mean of %u values x %u rounds)\n",
+                (uint32_t)BENCH_COUNT(bench_values_u32), (uint32_t)NUMFMT_BENCH_ROUNDS);
+    uart_printf("  u32: legacy %6u  numfmt %6u\n", legacy32, fast32);
+    uart_printf("  u64: legacy %6u  numfmt %6u\n", legacy64, fast64);
+}
@@ -0,0 +1,75 @@
+/*
+ * Profile Dump for Profile-Guided Optimization
+ * Uses the freestanding libgcov interface (GCC 13 and later): no file
+ * system, no constructors registering the objects, and the output goes
+ * wherever the dump callback sends it.
+ */
+
+#ifdef PGO_GENERATE
+
+#include <gcov.h>
+#include "pgo.h"
+#include "uart_pl011.h"
+#include "numfmt.h"
+
+/* Record table from linker_m33.ld */
+extern const struct gcov_info* const __gcov_info_start[];
+extern const struct gcov_info* const __gcov_info_end[];
+
+/* Scratch memory libgcov asks for while converting one object */
+#define PGO_SCRATCH_SIZE    2048
+
+static uint8_t pgo_scratch[PGO_SCRATCH_SIZE] __attribute__((aligned(8)));
+static uint32_t pgo_scratch_used;
+
+/* Hex-encode a chunk of the gcda stream */
+static void pgo_write_hex(const void* data, unsigned len, void* arg) {
+    const uint8_t* p = (const uint8_t*)data;
+    char hex[64];
+    uint32_t n = 0;
+
+    while (len--) {
+        hex[n++] = numfmt_hex_lower[*p >> 4];
+        hex[n++] = numfmt_hex_lower[*p & 0xF];
+        p++;
+        if (n == sizeof(hex)) {
+            uart_write(hex, n);
+            n = 0;
+        }
+    }
+    uart_write(hex, n);
+}
+
+static void pgo_write_filename(const char* filename, void* arg) {
+    __gcov_filename_to_gcfn(filename, pgo_write_hex, arg);
+}
+
+static void* pgo_allocate(unsigned length, void* arg) {
+    uint32_t offset = (pgo_scratch_used + 7) & ~7u;
+
+    if (length > PGO_SCRATCH_SIZE - offset) {
+        return 0;
+    }
+    pgo_scratch_used = offset + length;
+    return &pgo_scratch[offset];
+}
+
+void pgo_dump(void) {
+    const struct gcov_info* const* info = __gcov_info_start;
+    const struct gcov_info* const* end = __gcov_info_end;
+
+    /* The table bounds are not known to the compiler; keep it from
+     * assuming the two symbols are distinct objects */
+    __asm__ ("" : "+r" (info));
+
+    uart_write("gcov begin\r\n", 12);
+    for (; info != end; info++) {
+        pgo_scratch_used = 0;
+        __gcov_info_to_gcda(*info, pgo_write_filename, pgo_write_hex, pgo_allocate, 0);
+        uart_write("\r\n", 2);
+    }
+    uart_write("gcov end\r\n", 10);
+    uart_flush();
+}
+
+#endif /* PGO_GENERATE */
@@ -0,0 +1,17 @@
+/*
+ * Profile Dump for Profile-Guided Optimization
+ * In an instrumented build ("make PGO=generate", driven by "make pgo") the
+ * compiler keeps edge counters in RAM and lists one gcov_info record per
+ * object file in the .gcov_info section. pgo_dump() serializes them in the
+ * gcda stream format as hex lines between "gcov begin" and "gcov end", for
+ * tools/pgo_extract.py and "gcov-tool merge-stream" on the host.
+ */
+
+#ifndef PGO_H
+#define PGO_H
+
+/* Write every object's counters to the UART and wait until they are sent.
+ * Only defined in PGO_GENERATE builds. */
+void pgo_dump(void);
+
+#endif /* PGO_H */
@@ -0,0 +1,101 @@
+/*
+ * Fixed-Block Pool Allocator
+ * A block's first word holds the index of the next free block while it is
+ * on the free list. A popper may read that word after another context has
+ * already taken the block; the version tag in the head makes its CAS fail.
+ */
+
+#include "pool.h"
+#include "uart_printf.h"
+
+#define POOL_NONE       0xFFFFu     /* index of "no block" */
+#define POOL_TAG_ONE    0x10000u    /* one step of the version tag */
+
+static uint8_t* pool_block(const pool_t* pool, uint32_t index) {
+    return pool->base + index * pool->block_size;
+}
+
+/* Record a new occupancy level in the peak */
+static void pool_note_peak(pool_t* pool, uint32_t in_use) {
+    uint32_t peak = __atomic_load_n(&pool->peak, __ATOMIC_RELAXED);
+
+    while (in_use > peak &&
+           !__atomic_compare_exchange_n(&pool->peak, &peak, in_use, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+int pool_init(pool_t* pool, const char* name, void* mem, uint32_t block_size, uint32_t block_count) {
+    uint32_t size = (block_size + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+
+    if (mem == 0 || ((uintptr_t)mem & (POOL_ALIGN - 1)) || block_count == 0 ||
+        block_count >= POOL_MAX_BLOCKS) {
+        return -1;
+    }
+
+    pool->name = name;
+    pool->base = (uint8_t*)mem;
+    pool->block_size = size ? size : POOL_ALIGN;
+    pool->block_count = block_count;
+    pool->in_use = 0;
+    pool->peak = 0;
+    pool->failures = 0;
+
+    /* Chain every block to the next one in address order */
+    for (uint32_t i = 0; i < block_count; i++) {
+        *(uint32_t*)pool_block(pool, i) = i + 1 < block_count ? i + 1 : POOL_NONE;
+    }
+    pool->head = 0;
+    return 0;
+}
+
+void* pool_alloc(pool_t* pool) {
+    uint32_t head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+    uint32_t index;
+    uint32_t in_use;
+
+    do {
+        index = head & 0xFFFFu;
+        if (index == POOL_NONE) {
+            __atomic_add_fetch(&pool->failures, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(
+                 &pool->head, &head,
+                 ((head & ~0xFFFFu) + POOL_TAG_ONE) | *(volatile uint32_t*)pool_block(pool, index),
+                 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    in_use = __atomic_add_fetch(&pool->in_use, 1, __ATOMIC_RELAXED);
+    pool_note_peak(pool, in_use);
+    return pool_block(pool, index);
+}
+
+void pool_free(pool_t* pool, void* block) {
+    uint32_t offset;
+    uint32_t index;
+    uint32_t head;
+
+    if (block == 0 || (uint8_t*)block < pool->base) {
+        return;
+    }
+    offset = (uint32_t)((uint8_t*)block - pool->base);
+    index = offset / pool->block_size;
+    if (index >= pool->block_count || index * pool->block_size != offset) {
+        return;
+    }
+
+    head = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+    do {
+        *(volatile uint32_t*)block = head & 0xFFFFu;
+    } while (!__atomic_compare_exchange_n(&pool->head, &head,
+                                          ((head & ~0xFFFFu) + POOL_TAG_ONE) | index,
+                                          1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    __atomic_sub_fetch(&pool->in_use, 1, __ATOMIC_RELAXED);
+}
+
+void pool_report(const pool_t* pool) {
+    uart_printf("Pool %-8s %3u x %4u bytes: in use %u, peak %u, failed %u\n",
+                pool->name, pool->block_count, pool->block_size,
+                pool->in_use, pool->peak, pool->failures);
+}
@@ -0,0 +1,50 @@
+/*
+ * Fixed-Block Pool Allocator
+ * Blocks of one size carved from a caller-supplied buffer (usually an
+ * arena_alloc() from the heap arena). Free blocks are chained through
+ * their first word, and the list head is swapped with a compare-and-swap
+ * (LDREX/STREX), so pool_alloc() and pool_free() are O(1), take no lock
+ * and may be called from interrupt handlers. The head carries a 16-bit
+ * version tag next to the block index to rule out ABA races.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+
+/* Block alignment; block sizes are rounded up to a multiple of it */
+#define POOL_ALIGN          8u
+
+/* Largest number of blocks per pool (indices are 16 bits, one is reserved) */
+#define POOL_MAX_BLOCKS     0xFFFFu
+
+typedef struct {
+    const char* name;
+    uint8_t* base;
+    uint32_t block_size;
+    uint32_t block_count;
+    volatile uint32_t head;         /* version tag << 16 | first free index */
+    volatile uint32_t in_use;       /* blocks currently allocated */
+    volatile uint32_t peak;         /* highest in_use seen */
+    volatile uint32_t failures;     /* allocations refused because empty */
+} pool_t;
+
+/* Space needed for block_count blocks of block_size bytes */
+#define POOL_BYTES(block_size, block_count) \
+    ((((block_size) + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1)) * (block_count))
+
+/* Build the free list over mem (POOL_ALIGN aligned, POOL_BYTES() long).
+ * Returns 0, or -1 if mem is null or misaligned or the count is out of range. */
+int pool_init(pool_t* pool, const char* name, void* mem, uint32_t block_size, uint32_t block_count);
+
+/* Take a block, or return null if the pool is empty */
+void* pool_alloc(pool_t* pool);
+
+/* Return a block; null and pointers outside the pool are ignored */
+void pool_free(pool_t* pool, void* block);
+
+/* Print occupancy statistics over the UART */
+void pool_report(const pool_t* pool);
+
+#endif /* POOL_H */
@@ -0,0 +1,82 @@
+/*
+ * DWT Cycle-Counter Profiling
+ * The cycle counter itself is started in SystemInit(), so scopes can be
+ * measured from the first line of main(). Recording costs a handful of
+ * cycles: a subtraction, a CLZ for the histogram bin and a few stores.
+ */
+
+#include "profile.h"
+#include "uart_printf.h"
+
+/* Scope table boundaries provided by linker_m33.ld */
+extern profile_scope_t __profile_scopes_start[];
+extern profile_scope_t __profile_scopes_end[];
+
+/* Cycles attributed to an empty BEGIN/END pair, subtracted from samples */
+static uint32_t profile_overhead;
+
+void profile_init(void) {
+    uint32_t best = UINT32_MAX;
+
+    /* The fastest of a few empty measurements is the fixed overhead */
+    for (uint32_t i = 0; i < 8; i++) {
+        uint32_t start = dwt_cycles();
+        uint32_t cycles = dwt_cycles() - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    profile_overhead = best;
+}
+
+void profile_record(profile_scope_t* scope, uint32_t cycles) {
+    uint32_t bin;
+
+    cycles = cycles > profile_overhead ? cycles - profile_overhead : 0;
+    bin = 31 - (uint32_t)__builtin_clz(cycles | 1);
+
+    scope->count++;
+    scope->total += cycles;
+    if (cycles < scope->min) {
+        scope->min = cycles;
+    }
+    if (cycles > scope->max) {
+        scope->max = cycles;
+    }
+    scope->hist[bin < PROFILE_HIST_BINS ? bin : PROFILE_HIST_BINS - 1]++;
+}
+
+void profile_reset(void) {
+    for (profile_scope_t* scope = __profile_scopes_start; scope < __profile_scopes_end; scope++) {
+        scope->count = 0;
+        scope->min = UINT32_MAX;
+        scope->max = 0;
+        scope->total = 0;
+        for (uint32_t bin = 0; bin < PROFILE_HIST_BINS; bin++) {
+            scope->hist[bin] = 0;
+        }
+    }
+}
+
+void profile_dump(void) {
+    uart_printf("Profile (DWT cycles, overhead %u subtracted)\n", profile_overhead);
+    uart_printf("  %-20s %8s %10s %10s %10s\n", "scope", "count", "min", "mean", "max");
+
+    for (profile_scope_t* scope = __profile_scopes_start; scope < __profile_scopes_end; scope++) {
+        if (scope->count == 0) {
+            continue;
+        }
+
+        uart_printf("  %-20s %8u %10u %10u %10u\n", scope->name, scope->count, scope->min,
+                    (uint32_t)(scope->total / scope->count), scope->max);
+
+        /* Histogram: "2^n:count" for every populated bin */
+        uart_printf("    log2 hist:");
+        for (uint32_t bin = 0; bin < PROFILE_HIST_BINS; bin++) {
+            if (scope->hist[bin]) {
+                uart_printf(" 2^%u:%u", bin, scope->hist[bin]);
+            }
+        }
+        uart_printf("\n");
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * DWT Cycle-Counter Profiling
+ * PROFILE_BEGIN(name) / PROFILE_END(name) bracket a scope and record its
+ * duration in DWT cycles. Every scope owns a statically allocated entry
+ * in the .profile_scopes table (collected by linker_m33.ld), so no
+ * registration is needed; profile_dump() prints the whole table.
+ *
+ * Define PROFILE_DISABLE to compile all scopes out.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include "cortex_m33.h"
+
+/* log2 histogram: bin n counts durations in [2^n, 2^(n+1)), bin 0 also 0 */
+#define PROFILE_HIST_BINS   32
+
+typedef struct {
+    const char* name;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[PROFILE_HIST_BINS];
+} profile_scope_t;
+
+/* Measure the cost of an empty scope so it can be subtracted */
+void profile_init(void);
+
+/* Add one sample of cycles to a scope */
+void profile_record(profile_scope_t* scope, uint32_t cycles);
+
+/* Print every scope that has samples over the UART */
+void profile_dump(void);
+
+/* Clear all samples */
+void profile_reset(void);
+
+#ifndef PROFILE_DISABLE
+
+#define PROFILE_SCOPE_(name)                                                \
+    static profile_scope_t profile_scope_##name                             \
+        __attribute__((section(".profile_scopes"), used)) =                 \
+        { #name, 0, UINT32_MAX, 0, 0, { 0 } }
+
+#define PROFILE_BEGIN(name)                                                 \
+    PROFILE_SCOPE_(name);                                                   \
+    uint32_t profile_start_##name = dwt_cycles()
+
+#define PROFILE_END(name)                                                   \
+    profile_record(&profile_scope_##name, dwt_cycles() - profile_start_##name)
+
+/* Record a duration measured elsewhere (e.g. cycles since reset) */
+#define PROFILE_SAMPLE(name, cycles)                                        \
+    do {                                                                    \
+        PROFILE_SCOPE_(name);                                               \
+        profile_record(&profile_scope_##name, (cycles));                    \
+    } while (0)
+
+#else
+
+#define PROFILE_BEGIN(name)             do { } while (0)
+#define PROFILE_END(name)               do { } while (0)
+#define PROFILE_SAMPLE(name, cycles)    do { (void)(cycles); } while (0)
+
+#endif /* PROFILE_DISABLE */
+
+#endif /* PROFILE_H */
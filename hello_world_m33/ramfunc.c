@@ -0,0 +1,39 @@
+/*
+ * SRAM-Resident Library Routines
+ * memcpy() replaces the newlib version for the whole image (compiler
+ * generated struct copies included) and runs from SRAM.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ramfunc.h"
+
+/* Word copies when both pointers share alignment, bytes otherwise.
+ * Loop-to-memcpy pattern detection is disabled so the body cannot call itself.
+ * "used" keeps it through LTO, where calls the compiler emits for struct
+ * copies are not visible when unreferenced symbols are dropped. */
+void* memcpy(void* dst, const void* src, size_t len);
+
+RAMFUNC __attribute__((used, optimize("no-tree-loop-distribute-patterns")))
+void* memcpy(void* dst, const void* src, size_t len) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    if ((((uintptr_t)d ^ (uintptr_t)s) & 3u) == 0) {
+        while (((uintptr_t)d & 3u) && len) {
+            *d++ = *s++;
+            len--;
+        }
+        while (len >= 4) {
+            *(uint32_t*)d = *(const uint32_t*)s;
+            d += 4;
+            s += 4;
+            len -= 4;
+        }
+    }
+    while (len--) {
+        *d++ = *s++;
+    }
+
+    return dst;
+}
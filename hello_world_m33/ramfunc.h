@@ -0,0 +1,20 @@
+/*
+ * SRAM-Resident Code
+ * Functions tagged RAMFUNC are linked into the .ramfunc section, stored in
+ * flash after .text and copied to SRAM by Reset_Handler together with
+ * .data, so they execute without flash wait states on silicon.
+ *
+ * SRAM sits 512 MB away from flash, beyond the range of a BL, so tagged
+ * functions are called through a register (long_call); calls from SRAM
+ * back into flash get linker veneers. Tag leaf-heavy hot paths only.
+ */
+
+#ifndef RAMFUNC_H
+#define RAMFUNC_H
+
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline, long_call))
+
+/* Cycle-count comparison of the same loop run from flash and from SRAM */
+void ramfunc_bench(void);
+
+#endif /* RAMFUNC_H */
@@ -0,0 +1,63 @@
+/*
+ * Stack Usage Measurement
+ * The search only looks below the current SP: everything above it is
+ * live now and was therefore used.
+ */
+
+#include "stack.h"
+#include "uart_printf.h"
+#include "stack_guard.h"
+
+/* Paint that must lie below a used word before the scan accepts it as
+ * the peak. A frame leaves holes of paint (unwritten locals, padding, FP
+ * space reserved by lazy stacking), but "make stack-check" bounds every
+ * frame to STACK_GUARD_SIZE, so no hole is larger than that. */
+#define STACK_HOLE_WORDS    (STACK_GUARD_SIZE / 4)
+
+/* Stack boundaries from linker_m33.ld */
+extern uint32_t _stack_start[];
+extern uint32_t _estack[];
+
+uint32_t stack_size(void) {
+    return (uint32_t)((char*)_estack - (char*)_stack_start);
+}
+
+uint32_t stack_high_water(void) {
+    uint32_t* sp;
+    uint32_t lo = 0;
+    uint32_t hi;
+
+    __asm__ volatile ("mov %0, sp" : "=r" (sp));
+    hi = (uint32_t)(sp - _stack_start);
+
+    /* Find a word in [lo, hi) that is not paint. Holes of paint inside
+     * used frames make the predicate non-monotonic, so this may land
+     * above the real peak; the scan below corrects it. */
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (_stack_start[mid] == STACK_PAINT) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* Walk down until STACK_HOLE_WORDS of paint follow the lowest used word */
+    for (uint32_t i = lo; i > 0 && lo - i < STACK_HOLE_WORDS; ) {
+        i--;
+        if (_stack_start[i] != STACK_PAINT) {
+            lo = i;
+        }
+    }
+
+    return (uint32_t)((char*)_estack - (char*)&_stack_start[lo]);
+}
+
+void stack_report(void) {
+    uint32_t size = stack_size();
+    uint32_t used = stack_high_water();
+
+    uart_printf("Stack: peak %u of %u bytes (%u%%), %u bytes headroom\n",
+                used, size, used * 100 / size, size - used);
+}
@@ -0,0 +1,29 @@
+/*
+ * Stack Usage Measurement
+ * Reset_Handler paints the stack between _stack_start and the initial SP
+ * with STACK_PAINT before main() runs. The high-water mark is the lowest
+ * word that no longer holds the pattern; it is found with a binary search
+ * and confirmed by a linear scan of STACK_GUARD_SIZE bytes below it, so a
+ * scan costs under a hundred loads regardless of the stack size.
+ */
+
+#ifndef STACK_H
+#define STACK_H
+
+#include <stdint.h>
+
+/* Paint pattern (also hard-coded in startup_m33.S) */
+#define STACK_PAINT     0xDEADBEEFu
+
+/* Total stack size in bytes (_stack_size in linker_m33.ld) */
+uint32_t stack_size(void);
+
+/* Peak stack usage in bytes since reset. Unwritten words inside used
+ * frames are tolerated as long as each run of them is shorter than
+ * STACK_GUARD_SIZE, the frame limit enforced by "make stack-check". */
+uint32_t stack_high_water(void);
+
+/* Print size, peak usage and headroom over the UART */
+void stack_report(void);
+
+#endif /* STACK_H */
@@ -0,0 +1,125 @@
+/*
+ * MPU Stack Guard
+ * The MPU is enabled with PRIVDEFENA, so all other code keeps the default
+ * memory map and only the guard region is checked. The fault handler moves
+ * to a stack of its own first: the faulting one is exhausted by definition.
+ */
+
+#include "stack_guard.h"
+#include "uart_pl011.h"
+#include "numfmt.h"
+#include "cortex_m33.h"
+
+/* Guard boundaries from linker_m33.ld */
+extern uint32_t _stack_guard[];
+extern uint32_t _stack_start[];
+
+/* MPU region used for the guard */
+#define STACK_GUARD_REGION  0
+
+/* Stack of the fault reporter */
+#define FAULT_STACK_WORDS   128
+#define FAULT_STR_(x)       #x
+#define FAULT_STR(x)        FAULT_STR_(x)
+
+/* Referenced by name from MemManage_Handler's assembly only, so both are
+ * "used" and have external linkage (LTO may drop or rename static symbols) */
+uint32_t stack_guard_fault_stack[FAULT_STACK_WORDS] __attribute__((used, aligned(8)));
+void stack_guard_report(const uint32_t* frame, uint32_t exc_return) __attribute__((used, noreturn));
+
+void stack_guard_init(void) {
+    /* Attribute 0: normal memory, non-cacheable (the guard is never accessed) */
+    MPU_MAIR0 = 0x44;
+
+    MPU_RNR = STACK_GUARD_REGION;
+    MPU_RBAR = (uint32_t)_stack_guard | MPU_RBAR_AP_RO_PRIV | MPU_RBAR_XN;
+    MPU_RLAR = (((uint32_t)_stack_start - 1) & ~0x1Fu) | MPU_RLAR_EN;
+
+    MPU_CTRL = MPU_CTRL_PRIVDEFENA | MPU_CTRL_ENABLE;
+    SCB_SHCSR |= SCB_SHCSR_MEMFAULTENA;
+    cpu_barrier();
+}
+
+/* Append "name 0x<value>" to buf and return the new end */
+static char* fault_field(char* buf, const char* name, uint32_t value) {
+    while (*name) {
+        *buf++ = *name++;
+    }
+    *buf++ = '0';
+    *buf++ = 'x';
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        *buf++ = numfmt_hex_lower[(value >> shift) & 0xF];
+    }
+    return buf;
+}
+
+static void fault_puts(const char* str) {
+    const char* end = str;
+
+    while (*end) {
+        end++;
+    }
+    uart_write_polled(str, (uint32_t)(end - str));
+}
+
+/* Called by MemManage_Handler on the fault stack with the exception frame
+ * (r0-r3, r12, lr, pc, xpsr) of the interrupted code and EXC_RETURN */
+void stack_guard_report(const uint32_t* frame, uint32_t exc_return) {
+    uint32_t cfsr = SCB_CFSR;
+    uint32_t mmfar = SCB_MMFAR;
+    uint32_t guard = (uint32_t)_stack_guard;
+    char line[64];
+    char* p;
+    /* SP before stacking: past the basic frame (8 words) or, with EXC_RETURN
+     * bit 4 clear, the extended one with s0-s15 and FPSCR (26 words), plus
+     * the alignment word if xPSR bit 9 says one was inserted */
+    uint32_t sp = (uint32_t)(frame + ((exc_return & 0x10) ? 8 : 26) + ((frame[7] >> 9) & 1));
+
+    /* Stacking into the guard failed, so the frame was never written and
+     * its PC and LR words hold whatever the guard contained. SP points at
+     * where the frame would have gone, just below the overflowing SP. */
+    if (cfsr & SCB_CFSR_MSTKERR) {
+        fault_puts("\r\n*** MemManage: stack overflow, frame not stacked (PC/LR invalid)\r\n");
+    } else if ((cfsr & SCB_CFSR_MMARVALID) && mmfar - guard < STACK_GUARD_SIZE) {
+        fault_puts("\r\n*** MemManage: stack overflow\r\n");
+    } else {
+        fault_puts("\r\n*** MemManage fault\r\n");
+    }
+
+    p = fault_field(line, "PC ", frame[6]);
+    p = fault_field(p, "  LR ", frame[5]);
+    p = fault_field(p, "  SP ", sp);
+    *p++ = '\r';
+    *p++ = '\n';
+    uart_write_polled(line, (uint32_t)(p - line));
+
+    p = fault_field(line, "CFSR ", cfsr);
+    if (cfsr & SCB_CFSR_MMARVALID) {
+        p = fault_field(p, "  MMFAR ", mmfar);
+    }
+    *p++ = '\r';
+    *p++ = '\n';
+    uart_write_polled(line, (uint32_t)(p - line));
+
+    while (1) {
+        cpu_wfi();
+    }
+}
+
+/* Take the frame pointer from the stack that was active (EXC_RETURN bit 2)
+ * and pass EXC_RETURN along, then switch MSP to the fault stack before any
+ * C code pushes to it */
+__attribute__((naked))
+void MemManage_Handler(void) {
+    __asm__ volatile (
+        "tst    lr, #4\n\t"
+        "ite    eq\n\t"
+        "mrseq  r0, msp\n\t"
+        "mrsne  r0, psp\n\t"
+        "mov    r1, lr\n\t"
+        "ldr    r2, =stack_guard_fault_stack + 4 * " FAULT_STR(FAULT_STACK_WORDS) "\n\t"
+        "msr    msp, r2\n\t"
+        "b      stack_guard_report\n\t"
+        ".ltorg"
+    );
+}
@@ -0,0 +1,31 @@
+/*
+ * MPU Stack Guard
+ * A read-only MPU region directly below _stack_start turns a stack
+ * overflow into a MemManage fault at the first store past the end of the
+ * stack. Unlike compiled-in canaries (-fstack-protector) this costs
+ * nothing per call; the check is done by the MPU on every access.
+ */
+
+#ifndef STACK_GUARD_H
+#define STACK_GUARD_H
+
+#include <stdint.h>
+
+/* Guard size in bytes (passed to linker_m33.ld as _stack_guard_size), a multiple of
+ * the 32-byte PMSAv8 granule. A prologue pushes at the top of its frame and
+ * then moves SP past the rest with a single "sub sp", so a guard smaller
+ * than a frame can be stepped over without a store ever landing in it.
+ * The build checks every frame from -fstack-usage against this size
+ * ("make stack-check"); a frame that crosses _stack_start then still ends
+ * inside the guard, where its own stores or the next call's push fault. */
+#define STACK_GUARD_SIZE    256
+
+/* Program the guard region and enable the MPU and MemManage exception.
+ * Only touches registers, so it can run from SystemInit(). */
+void stack_guard_init(void);
+
+/* Print the faulting PC, LR and SP with polled UART writes and halt.
+ * Installed in the vector table through the weak MemManage_Handler alias. */
+void MemManage_Handler(void);
+
+#endif /* STACK_GUARD_H */
@@ -0,0 +1,245 @@
+/*
+ * SysTick Timebase
+ * The SysTick counter runs from the 1 MHz reference clock and interrupts
+ * every millisecond. Sub-millisecond time comes from the current counter
+ * value, so sleeps are exact to a microsecond without a calibrated loop.
+ *
+ * Long sleeps are tickless: the tick interrupt is suppressed and the
+ * counter is stretched to the wake-up boundary, so the core executes
+ * nothing until the deadline and Renode can skip the idle time.
+ */
+
+#include "systick.h"
+#include "cortex_m33.h"
+#include "ramfunc.h"
+
+#if (SYSTICK_CLOCK_HZ % 1000000u) != 0 || (SYSTICK_CLOCK_HZ % SYSTICK_TICK_HZ) != 0
+#error "SYSTICK_CLOCK_HZ must be a whole number of MHz and a multiple of SYSTICK_TICK_HZ"
+#endif
+
+#define SYSTICK_US_PER_TICK (1000000u / SYSTICK_TICK_HZ)
+
+/* Longest stretched count that still fits the 24-bit reload register */
+#define SYSTICK_MAX_IDLE_TICKS  (0x00FFFFFFu / SYSTICK_RELOAD)
+
+/* Core clocks per reference clock, to credit time the counter was stopped */
+#if (BOARD_CLOCK_CPU_HZ % SYSTICK_CLOCK_HZ) != 0
+#error "BOARD_CLOCK_CPU_HZ must be a multiple of SYSTICK_CLOCK_HZ"
+#endif
+#define SYSTICK_CPU_PER_CLK (BOARD_CLOCK_CPU_HZ / SYSTICK_CLOCK_HZ)
+
+/* SysTick has the lowest priority so it never delays the UART */
+#define SYSTICK_PRIORITY    0xF0u
+
+/* Milliseconds elapsed, advanced by SysTick_Handler */
+static volatile uint32_t systick_ticks;
+
+/* Core cycles of stopped counter not yet credited (under one reference clock) */
+static uint32_t systick_stopped_cycles;
+
+void systick_init(void) {
+    SYST_CSR = 0;
+    systick_ticks = 0;
+
+    SCB_SHPR3 = (SCB_SHPR3 & 0x00FFFFFFu) | (SYSTICK_PRIORITY << 24);
+
+    /* Count the reference clock down from RELOAD - 1 to 0 once per tick */
+    SYST_RVR = SYSTICK_RELOAD - 1;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_ENABLE | SYST_CSR_TICKINT;
+}
+
+RAMFUNC
+void SysTick_Handler(void) {
+    systick_ticks = systick_ticks + 1;
+}
+
+uint32_t systick_ms(void) {
+    return systick_ticks;
+}
+
+uint32_t systick_us(void) {
+    uint32_t ticks;
+    uint32_t count;
+    uint32_t wrapped;
+
+    /* Re-read if the tick interrupt ran between the loads. A wrap whose
+     * interrupt is still pending (interrupts masked, or called from a
+     * handler that outranks SysTick) has not reached systick_ticks yet:
+     * count it here, with the counter re-read after the wrap. Counter
+     * value 0 is still the end of the old tick. */
+    do {
+        ticks = systick_ticks;
+        count = SYST_CVR;
+        wrapped = 0;
+        if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+            count = SYST_CVR;
+            wrapped = count != 0;
+        }
+    } while (ticks != systick_ticks);
+
+    return (ticks + wrapped) * SYSTICK_US_PER_TICK + (SYSTICK_RELOAD - 1 - count) / SYSTICK_CLK_PER_US;
+}
+
+/* Stop the counter and return the DWT time of the stop */
+static uint32_t systick_stop(void) {
+    SYST_CSR = SYST_CSR_TICKINT;
+    return dwt_cycles();
+}
+
+/* Restart a counter stopped at stopped_at so that it next reaches zero
+ * (the tick event) to_zero reference clocks after the stop, as if it had
+ * never stopped; later periods use the regular reload. Returns the tick
+ * boundaries that fell inside the stop, for the caller to credit.
+ *
+ * The counter takes RVR only on its next reference clock edge after CVR is
+ * cleared, about 100 core cycles later, so RVR is restored once that load
+ * is visible. The clocks missed while stopped are measured on the DWT
+ * counter; the sub-clock remainder carries over to the next stop. */
+static uint32_t systick_restart(uint32_t to_zero, uint32_t stopped_at) {
+    uint32_t missed;
+    uint32_t crossed = 0;
+
+    systick_stopped_cycles += dwt_cycles() - stopped_at;
+    missed = systick_stopped_cycles / SYSTICK_CPU_PER_CLK;
+    systick_stopped_cycles -= missed * SYSTICK_CPU_PER_CLK;
+
+    /* The first edge after the restart only loads RVR */
+    missed += 1;
+    while (to_zero <= missed) {
+        to_zero += SYSTICK_RELOAD;
+        crossed++;
+    }
+
+    SYST_RVR = to_zero - missed;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_ENABLE | SYST_CSR_TICKINT;
+    while (SYST_CVR == 0) {
+        /* Wait for the reference clock edge that loads RVR */
+    }
+    SYST_RVR = SYSTICK_RELOAD - 1;
+
+    return crossed;
+}
+
+/* Sleep through up to idle_ticks tick boundaries with the tick interrupt
+ * suppressed, then credit the ticks that passed. Any other interrupt ends
+ * the sleep early. Interrupts stay masked while the counter is stretched,
+ * so no handler ever observes the long count. The optional pending
+ * check runs masked too, so work queued just before the call is not slept on. */
+static void systick_idle(uint32_t idle_ticks, uint32_t (*pending)(void)) {
+    uint32_t primask;
+    uint32_t stopped_at;
+    uint32_t count;
+    uint32_t to_zero;       /* clocks to the next tick event */
+    uint32_t ahead;         /* tick events left before the deadline's */
+    uint32_t completed;     /* whole ticks to credit here */
+
+    if (idle_ticks > SYSTICK_MAX_IDLE_TICKS) {
+        idle_ticks = SYSTICK_MAX_IDLE_TICKS;
+    }
+
+    primask = irq_save();
+    if (pending && pending()) {
+        irq_restore(primask);
+        return;
+    }
+    if (idle_ticks < 2) {
+        /* The next regular tick is the wake-up anyway */
+        cpu_wfi();
+        irq_restore(primask);
+        return;
+    }
+
+    stopped_at = systick_stop();
+    count = SYST_CVR;
+    to_zero = count ? count : SYSTICK_RELOAD;
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+        /* A tick is already due: let its handler run instead */
+        systick_ticks = systick_ticks + systick_restart(to_zero, stopped_at);
+        irq_restore(primask);
+        return;
+    }
+
+    /* Stretch the count to end exactly on the idle_ticks-th tick event.
+     * Only this one period is long: RVR is back at the regular reload. */
+    systick_ticks = systick_ticks +
+        systick_restart(to_zero + (idle_ticks - 1) * SYSTICK_RELOAD, stopped_at);
+
+    cpu_wfi();
+
+    stopped_at = systick_stop();
+    count = SYST_CVR;
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET) {
+        /* Slept the full period and the counter is back to regular ticks;
+         * the pending handler credits the last tick */
+        completed = idle_ticks - 1;
+        to_zero = count ? count : SYSTICK_RELOAD;
+    } else {
+        /* Woken early by another interrupt: count clocks remain to the
+         * deadline, so the next tick event is count mod RELOAD away */
+        ahead = count ? (count + SYSTICK_RELOAD - 1) / SYSTICK_RELOAD : 1;
+        completed = idle_ticks - ahead;
+        to_zero = count - (ahead - 1) * SYSTICK_RELOAD;
+    }
+    completed += systick_restart(to_zero, stopped_at);
+    systick_ticks = systick_ticks + completed;
+
+    irq_restore(primask);
+}
+
+void sleep_us(uint32_t us) {
+    uint32_t start = systick_us();
+    uint32_t elapsed;
+
+    while ((elapsed = systick_us() - start) < us) {
+        /* Idle tickless across whole ticks before the deadline, then
+         * finish the last fraction of a tick on the counter */
+        uint32_t remaining = us - elapsed;
+
+        if (remaining > SYSTICK_US_PER_TICK) {
+            systick_idle(remaining / SYSTICK_US_PER_TICK, 0);
+        }
+    }
+}
+
+void sleep_ms(uint32_t ms) {
+    /* Split long sleeps so the microsecond arithmetic never wraps */
+    while (ms > 1000u) {
+        sleep_us(1000000u);
+        ms -= 1000u;
+    }
+    sleep_us(ms * 1000u);
+}
+
+void sleep_until_ms(uint32_t deadline_ms) {
+    int32_t remaining;
+
+    /* Deadlines sit on tick boundaries, so no sub-tick polling is needed */
+    while ((remaining = (int32_t)(deadline_ms - systick_ticks)) > 0) {
+        systick_idle((uint32_t)remaining, 0);
+    }
+}
+
+void systick_idle_until_ms(uint32_t deadline_ms, uint32_t (*pending)(void)) {
+    int32_t remaining = (int32_t)(deadline_ms - systick_ticks);
+
+    if (remaining > 0) {
+        systick_idle((uint32_t)remaining, pending);
+    }
+}
+
+void timeout_start(timeout_t* timeout, uint32_t us) {
+    timeout->start_us = systick_us();
+    timeout->duration_us = us;
+}
+
+int timeout_expired(const timeout_t* timeout) {
+    return systick_us() - timeout->start_us >= timeout->duration_us;
+}
+
+uint32_t timeout_remaining_us(const timeout_t* timeout) {
+    uint32_t elapsed = systick_us() - timeout->start_us;
+
+    return elapsed >= timeout->duration_us ? 0 : timeout->duration_us - elapsed;
+}
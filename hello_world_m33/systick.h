@@ -0,0 +1,62 @@
+/*
+ * SysTick Timebase
+ * Monotonic millisecond tick, microsecond clock, calibrated sleeps and
+ * timeouts. Sleeping waits in WFI with the tick suppressed, so the core
+ * idles until the interrupt that ends the sleep.
+ */
+
+#ifndef SYSTICK_H
+#define SYSTICK_H
+
+#include <stdint.h>
+#include "board_config.h"
+
+/* SysTick reference clock from the board clock model (checked against
+ * systickFrequency in cortex_m33_platform.repl when board_config.h is generated) */
+#define SYSTICK_CLOCK_HZ    BOARD_CLOCK_SYSTICK_HZ
+
+/* Tick interrupt rate: one tick per millisecond */
+#define SYSTICK_TICK_HZ     1000u
+
+/* Counter reloads per tick and reference clocks per microsecond */
+#define SYSTICK_RELOAD      (SYSTICK_CLOCK_HZ / SYSTICK_TICK_HZ)
+#define SYSTICK_CLK_PER_US  (SYSTICK_CLOCK_HZ / 1000000u)
+
+/* A deadline measured in microseconds from the moment it was started */
+typedef struct {
+    uint32_t start_us;
+    uint32_t duration_us;
+} timeout_t;
+
+/* Start the 1 kHz tick interrupt */
+void systick_init(void);
+
+/* Milliseconds since systick_init() (wraps after ~49.7 days) */
+uint32_t systick_ms(void);
+
+/* Microseconds since systick_init() (wraps after ~71.6 minutes; use differences) */
+uint32_t systick_us(void);
+
+/* Sleep for at least the given time; whole ticks are slept tickless in WFI */
+void sleep_ms(uint32_t ms);
+void sleep_us(uint32_t us);
+
+/* Sleep until systick_ms() reaches deadline_ms, waking exactly on that tick.
+ * Periodic work should advance an absolute deadline to avoid drift. */
+void sleep_until_ms(uint32_t deadline_ms);
+
+/* Idle until deadline_ms or the first interrupt, whichever comes first.
+ * Returns at once if pending (may be null) reports queued work; it is
+ * checked with interrupts masked, so an event just before the call still
+ * ends the wait. Event loops call this instead of sleep_until_ms(). */
+void systick_idle_until_ms(uint32_t deadline_ms, uint32_t (*pending)(void));
+
+/* Arm a timeout of up to 2^31 microseconds and poll it for expiry */
+void timeout_start(timeout_t* timeout, uint32_t us);
+int timeout_expired(const timeout_t* timeout);
+uint32_t timeout_remaining_us(const timeout_t* timeout);
+
+/* SysTick exception handler (installed in the vector table by startup_m33.S) */
+void SysTick_Handler(void);
+
+#endif /* SYSTICK_H */
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# CoreMark-Style Benchmark Run
+# Builds bench/core_bench.elf, runs it headless in Renode for a fixed
+# amount of virtual time and writes bench_results.json: the per-kernel
+# DWT cycles and iterations per simulated second reported by the image,
+# plus the host-side emulation speed (instructions executed by the CPU
+# per wall-clock second, Renode start-up excluded).
+#
+# Usage: tools/bench.sh [virtual-seconds] [make options for bench/...]
+
+BENCH_SECONDS=${1:-5}
+shift
+OUTPUT=bench_results.json
+
+cd "$(dirname "$0")/.." || exit 1
+
+if ! command -v renode &> /dev/null; then
+    echo "Error: Renode not found!"
+    exit 1
+fi
+
+if ! make -s -C bench "$@" all > /dev/null; then
+    echo "Error: benchmark build failed"
+    exit 1
+fi
+
+# Wall-clock seconds and executed instruction count of a run of $1 virtual seconds
+run_for() {
+    local start end out
+    start=$(date +%s.%N)
+    out=$(cd bench && renode --disable-xwt --console --plain \
+        -e "include @core_bench.resc; runMacro \$fast_forward; emulation RunFor \"$1\"; cpu ExecutedInstructions; quit" 2>&1)
+    end=$(date +%s.%N)
+    echo "$(echo "$end - $start" | bc -l) $(echo "$out" | tr -d '\r' | grep -E '^[0-9]+$' | tail -1)"
+}
+
+echo "Running the benchmark for $BENCH_SECONDS s of virtual time..."
+read -r overhead _ <<< "$(run_for 0)"
+rm -f bench/uart_output.log
+read -r wall instructions <<< "$(run_for "$BENCH_SECONDS")"
+
+python3 tools/bench_json.py bench/uart_output.log "$OUTPUT" \
+    --wall "$(echo "$wall - $overhead" | bc -l)" \
+    --instructions "${instructions:-0}" \
+    --seconds "$BENCH_SECONDS" \
+    --options "$*"
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Collect the results of the CoreMark-style benchmark (see bench/core.h).
+
+Parses the "core ..." lines that bench/core_bench.elf wrote to the UART,
+adds the host-side measurements of tools/bench.sh and writes one JSON
+document, the baseline compared across emulator and compiler versions.
+
+Usage:
+    tools/bench_json.py bench/uart_output.log bench_results.json \\
+        --wall 3.2 --instructions 123456789 --seconds 5 --options "OPT=-O3"
+"""
+
+import argparse
+import json
+import re
+import sys
+
+FIELD_RE = re.compile(r"(\w+)=(\S+)")
+
+
+def parse(lines):
+    """Result document built from the "core" lines of a UART capture."""
+    result = {"kernels": {}, "done": False}
+    for line in lines:
+        line = line.strip()
+        if not line.startswith("core "):
+            continue
+        if line == "core done":
+            result["done"] = True
+            continue
+        if line.startswith("core compiler="):
+            result["compiler"] = line[len("core compiler="):]
+            continue
+
+        fields = dict(FIELD_RE.findall(line))
+        if "kernel" in fields:
+            result["kernels"][fields["kernel"]] = {
+                "cycles": int(fields["cycles"]),
+                "iterations_per_sim_second": float(fields["per_sec"]),
+                "crc": fields["crc"],
+                "check": fields["check"],
+                "status": fields["status"],
+            }
+        elif line.startswith("core total"):
+            result["total"] = {
+                "cycles": int(fields["cycles"]),
+                "iterations_per_sim_second": float(fields["per_sec"]),
+                "status": fields["status"],
+            }
+        elif "iterations" in fields:
+            result["iterations"] = int(fields["iterations"])
+            result["cpu_hz"] = int(fields["cpu_hz"])
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark UART log to JSON")
+    parser.add_argument("log", help="UART capture of bench/core_bench.elf")
+    parser.add_argument("json", help="output file")
+    parser.add_argument("--wall", type=float, required=True,
+                        help="wall-clock seconds of the run, Renode start-up excluded")
+    parser.add_argument("--instructions", type=int, required=True,
+                        help="instructions executed by the CPU (cpu ExecutedInstructions)")
+    parser.add_argument("--seconds", type=float, required=True,
+                        help="virtual seconds simulated")
+    parser.add_argument("--options", default="", help="make options of the build")
+    args = parser.parse_args()
+
+    with open(args.log, "r", encoding="latin-1") as f:
+        result = parse(f)
+
+    if not result["done"]:
+        sys.exit("bench_json: no \"core done\" in the log (run longer, or the image crashed)")
+
+    result["build_options"] = args.options
+    result["host"] = {
+        "wall_seconds": round(args.wall, 3),
+        "virtual_seconds": args.seconds,
+        "instructions": args.instructions,
+        "mips": round(args.instructions / args.wall / 1e6, 2) if args.wall > 0 else None,
+    }
+    del result["done"]
+
+    with open(args.json, "w") as f:
+        json.dump(result, f, indent=2)
+        f.write("\n")
+
+    total = result.get("total", {})
+    print(f"{total.get('iterations_per_sim_second', 0):.2f} iterations per simulated second, "
+          f"{result['host']['mips']} host MIPS, status {total.get('status', '?')} -> {args.json}")
+    if total.get("status") != "ok":
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+Report for the optimization-level matrix (see tools/bench_matrix.sh).
+
+For each configuration NAME the directory holds:
+
+    NAME.link.log   linker --print-memory-usage output
+    NAME.map        linker map file
+    NAME.uart.log   UART capture containing at least one profile_dump()
+
+Prints region usage and output section sizes, then the mean DWT cycles of
+every PROFILE_BEGIN/END scope from the last profile dump of each run.
+
+Usage:
+    tools/bench_matrix.py bench_matrix Os O2 O3 O2-lto
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Output sections reported from the map file
+SECTIONS = [".isr_vector", ".text", ".ramfunc", ".data", ".bss"]
+
+REGION_RE = re.compile(r"^\s*(\w+):\s+(\d+(?:\.\d+)?)\s*(B|KB|MB|GB)\s")
+SECTION_RE = re.compile(r"^(\.[\w.]+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+SCOPE_RE = re.compile(r"^\s+(\w+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s*$")
+UNITS = {"B": 1, "KB": 1024, "MB": 1024 ** 2, "GB": 1024 ** 3}
+
+
+def read_lines(path):
+    with open(path, "r", encoding="latin-1") as f:
+        return f.read().splitlines()
+
+
+def region_usage(lines):
+    """{region: used bytes} from a --print-memory-usage table."""
+    usage = {}
+    for line in lines:
+        m = REGION_RE.match(line)
+        if m:
+            usage[m.group(1)] = int(float(m.group(2)) * UNITS[m.group(3)])
+    return usage
+
+
+def section_sizes(lines):
+    """{output section: size} from the top-level entries of a map file."""
+    sizes = {}
+    for line in lines:
+        m = SECTION_RE.match(line)
+        if m and m.group(1) in SECTIONS:
+            sizes[m.group(1)] = int(m.group(3), 16)
+    return sizes
+
+
+def profile_means(lines):
+    """{scope: mean cycles} from the last profile dump in a UART log."""
+    means = {}
+    for line in lines:
+        if line.startswith("Profile (DWT cycles"):
+            means = {}
+            continue
+        m = SCOPE_RE.match(line)
+        if m:
+            means[m.group(1)] = int(m.group(4))
+    return means
+
+
+def print_table(title, rows, names):
+    print(title)
+    width = max([len(r) for r in rows] + [12])
+    print(f"  {'':<{width}}" + "".join(f"{n:>10}" for n in names))
+    for row, values in rows.items():
+        cells = "".join(f"{values.get(n, '-'):>10}" for n in names)
+        print(f"  {row:<{width}}{cells}")
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Size/cycle table of a bench-matrix run")
+    parser.add_argument("dir", help="directory written by tools/bench_matrix.sh")
+    parser.add_argument("names", nargs="+", help="configuration names, in column order")
+    args = parser.parse_args()
+
+    sizes = {}
+    cycles = {}
+    for name in args.names:
+        base = os.path.join(args.dir, name)
+        try:
+            usage = region_usage(read_lines(base + ".link.log"))
+            sections = section_sizes(read_lines(base + ".map"))
+            means = profile_means(read_lines(base + ".uart.log"))
+        except OSError as e:
+            sys.exit(f"bench_matrix: {e}")
+        if not means:
+            print(f"warning: no profile dump from {name} (run longer: BENCH_SECONDS)",
+                  file=sys.stderr)
+
+        for region, used in usage.items():
+            sizes.setdefault(f"{region} used", {})[name] = used
+        for section in SECTIONS:
+            if section in sections:
+                sizes.setdefault(section, {})[name] = sections[section]
+        for scope, mean in means.items():
+            cycles.setdefault(scope, {})[name] = mean
+
+    print_table("Size (bytes)", sizes, args.names)
+    print_table("Mean DWT cycles per profiled scope", cycles, args.names)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Optimization-Level Matrix
+# Builds hello_world_m33.elf once per optimization setting, runs each build
+# headless in Renode for a fixed amount of virtual time (long enough for
+# the profile dump at the first counter reset) and keeps the link output,
+# map file and UART capture of every run in bench_matrix/. The table of
+# sizes and profiled cycles is printed by tools/bench_matrix.py.
+#
+# Usage: tools/bench_matrix.sh [virtual-seconds]
+#
+# The settings default to -Os, -O2, -O3 and -O2 -flto; BENCH_OPTS replaces
+# them with a ";"-separated list of name:flags entries, e.g.
+#   BENCH_OPTS="O2:-O2;O2-unroll:-O2 -funroll-loops" tools/bench_matrix.sh
+
+BENCH_SECONDS=${1:-110}
+OUT_DIR=bench_matrix
+
+cd "$(dirname "$0")/.." || exit 1
+
+if ! command -v renode &> /dev/null; then
+    echo "Error: Renode not found!"
+    exit 1
+fi
+
+# Settings to compare, as "name:flags"
+BENCH_OPTS=${BENCH_OPTS:-"Os:-Os;O2:-O2;O3:-O3;O2-lto:-O2 -flto"}
+IFS=';' read -ra CONFIGS <<< "$BENCH_OPTS"
+
+rm -rf "$OUT_DIR"
+mkdir -p "$OUT_DIR"
+
+names=()
+for config in "${CONFIGS[@]}"; do
+    name=${config%%:*}
+    flags=${config#*:}
+
+    echo "== $name ($flags)"
+    # -s leaves only the linker's --print-memory-usage table on stdout
+    if ! make -s OPT="$flags" all > "$OUT_DIR/$name.link.log"; then
+        echo "Error: build with $flags failed"
+        exit 1
+    fi
+    cp hello_world_m33.map "$OUT_DIR/$name.map"
+
+    rm -f uart_output.log
+    renode --disable-xwt --console --plain \
+        -e "include @platform_startup_m33.resc; runMacro \$fast_forward; emulation RunFor \"$BENCH_SECONDS\"; quit" \
+        > /dev/null 2>&1
+    cp uart_output.log "$OUT_DIR/$name.uart.log"
+
+    names+=("$name")
+done
+
+echo ""
+python3 tools/bench_matrix.py "$OUT_DIR" "${names[@]}"
+
+# Leave the default build behind
+make -s all > /dev/null
@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# Soft- vs. Hard-Float Benchmark
+# Builds hello_world_m33.elf with DEFINES=-DFP_BENCH once per FLOAT_ABI,
+# runs each build headless in Renode for a short stretch of virtual time
+# and prints the "fp" lines each one wrote to the UART.
+#
+# Usage: tools/fp_bench.sh
+
+cd "$(dirname "$0")/.." || exit 1
+
+if ! command -v renode &> /dev/null; then
+    echo "Error: Renode not found!"
+    exit 1
+fi
+
+for abi in soft hard; do
+    if ! make -s FLOAT_ABI=$abi DEFINES=-DFP_BENCH all > /dev/null; then
+        echo "Error: $abi-float build failed"
+        exit 1
+    fi
+
+    rm -f uart_output.log
+    renode --disable-xwt --console --plain \
+        -e "include @platform_startup_m33.resc; runMacro \$fast_forward; emulation RunFor \"1\"; quit" \
+        > /dev/null 2>&1
+
+    echo "== FLOAT_ABI=$abi"
+    grep -a "^fp " uart_output.log | tr -d '\r'
+done
+
+# Leave the default build behind
+make -s all > /dev/null
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+Host-side decoder for tokenized UART logs (see log_tok.h).
+
+Reads the format strings from the .log_strings section of the firmware ELF
+and expands every token frame in a captured UART stream back into text.
+Plain text between frames is passed through unchanged.
+
+Usage:
+    tools/log_decode.py hello_world_m33.elf uart_output.log
+    tools/log_decode.py --follow hello_world_m33.elf uart_output.log
+"""
+
+import argparse
+import re
+import struct
+import sys
+import time
+
+FRAME_MARKER = 0x1E
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(r"%([-0]*)(\d*)(?:\.(\d+))?([udixXcsk%])")
+
+
+class Elf32:
+    """Minimal little-endian ELF32 section reader (no external dependencies)."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF32 file")
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+
+        headers = [struct.unpack_from("<IIIIIIIIII", self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        names_off = headers[shstrndx][4]
+
+        self.sections = {}
+        for name, stype, flags, addr, offset, size, *_ in headers:
+            end = self.data.index(b"\0", names_off + name)
+            sname = self.data[names_off + name:end].decode()
+            self.sections[sname] = (stype, flags, addr, offset, size)
+
+    def section_bytes(self, name):
+        stype, flags, addr, offset, size = self.sections[name]
+        return self.data[offset:offset + size]
+
+    def read_cstring(self, address):
+        """Read a NUL-terminated string from a loaded section by address."""
+        for stype, flags, addr, offset, size in self.sections.values():
+            if stype == SHT_PROGBITS and flags & SHF_ALLOC and addr <= address < addr + size:
+                start = offset + address - addr
+                return self.data[start:self.data.index(b"\0", start)].decode(errors="replace")
+        return f"<string@0x{address:08x}>"
+
+
+def read_varint(payload, pos):
+    value = shift = 0
+    while True:
+        byte = payload[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def render(fmt, args, elf):
+    """Expand the printf subset supported by uart_printf()."""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        sign = ""
+        if conv in "dik":
+            if value & 0x80000000:
+                value -= 1 << 32
+            if value < 0:
+                sign, value = "-", -value
+        if conv in "udi":
+            body = str(value)
+        elif conv == "x":
+            body = f"{value:x}"
+        elif conv == "X":
+            body = f"{value:X}"
+        elif conv == "c":
+            body = chr(value & 0xFF)
+        elif conv == "s":
+            body = elf.read_cstring(value)
+        else:  # k: decimal fixed point, value / 10^precision
+            digits = min(int(precision or 0), 9)
+            body = str(value)
+            if digits:
+                body = body.rjust(digits + 1, "0")
+                body = body[:-digits] + "." + body[-digits:]
+
+        width = int(width or 0)
+        fill = max(width - len(sign) - len(body), 0)
+        if "-" in flags:
+            return sign + body + " " * fill
+        if "0" in flags and conv != "s":
+            return sign + "0" * fill + body
+        return " " * fill + sign + body
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, elf):
+        self.elf = elf
+        self.strings = elf.section_bytes(".log_strings")
+        self.pending = b""
+        self.held_cr = ""
+
+    def format_for(self, token):
+        if token >= len(self.strings):
+            return None
+        end = self.strings.index(b"\0", token)
+        return self.strings[token:end].decode(errors="replace")
+
+    def feed(self, data):
+        """Decode as much of the stream as possible and return the text."""
+        buf = self.pending + data
+        out = []
+        pos = 0
+        while pos < len(buf):
+            byte = buf[pos]
+            if byte != FRAME_MARKER:
+                text_end = buf.find(bytes([FRAME_MARKER]), pos)
+                if text_end < 0:
+                    text_end = len(buf)
+                out.append(buf[pos:text_end].decode(errors="replace"))
+                pos = text_end
+                continue
+            if pos + 2 > len(buf) or pos + 2 + buf[pos + 1] > len(buf):
+                break  # incomplete frame, wait for more data
+            payload = buf[pos + 2:pos + 2 + buf[pos + 1]]
+            pos += 2 + len(payload)
+            try:
+                token, cursor = read_varint(payload, 0)
+                args = []
+                while cursor < len(payload):
+                    value, cursor = read_varint(payload, cursor)
+                    args.append(value)
+            except IndexError:
+                out.append("<truncated frame>\n")
+                continue
+            fmt = self.format_for(token)
+            if fmt is None:
+                out.append(f"<unknown token {token}>\n")
+            else:
+                out.append(render(fmt, args, self.elf))
+        self.pending = buf[pos:]
+
+        # Normalize line endings on the joined output, so a CRLF split
+        # across read() chunks or around a frame still becomes one "\n";
+        # a trailing "\r" waits for the next call to see what follows it
+        text = self.held_cr + "".join(out)
+        self.held_cr = "\r" if text.endswith("\r") else ""
+        if self.held_cr:
+            text = text[:-1]
+        return text.replace("\r\n", "\n")
+
+    def flush(self):
+        """Text held back at the end of the stream (a lone trailing "\r")."""
+        text, self.held_cr = self.held_cr, ""
+        return text
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF built with -DLOG_DEFERRED")
+    parser.add_argument("log", help="captured UART output (e.g. uart_output.log)")
+    parser.add_argument("--follow", action="store_true",
+                        help="keep reading as the log grows (like tail -f)")
+    args = parser.parse_args()
+
+    decoder = Decoder(Elf32(args.elf))
+    with open(args.log, "rb") as log:
+        while True:
+            chunk = log.read(4096)
+            if chunk:
+                sys.stdout.write(decoder.feed(chunk))
+                sys.stdout.flush()
+            elif args.follow:
+                time.sleep(0.2)
+            else:
+                sys.stdout.write(decoder.flush())
+                break
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Compressor for the .data initializer image (see data_lz.h).
+
+Encodes a raw .data image (objcopy -O binary --only-section=.data) as a
+stream of byte-aligned tokens that data_lz_unpack() expands at boot:
+
+    0lllllll                 literal run: the next l+1 bytes (1..128)
+    10llllll vvvvvvvv        fill: byte v repeated l+3 times (3..66)
+    11llllll dddddddd x2     match: copy l+4 bytes (4..67) from d+1 bytes
+                             back in the output (d is 16-bit little endian)
+
+The stream carries no length; the decompressor stops at _edata.
+
+Usage:
+    tools/pack_data.py data_raw.bin data_lz.bin
+"""
+
+import argparse
+import sys
+
+LITERAL_MAX = 128
+FILL_MIN, FILL_MAX = 3, 66
+MATCH_MIN, MATCH_MAX = 4, 67
+WINDOW = 65536
+
+
+def run_length(data, pos):
+    """Length of the run of data[pos] starting at pos, capped at FILL_MAX."""
+    end = min(len(data), pos + FILL_MAX)
+    n = 1
+    while pos + n < end and data[pos + n] == data[pos]:
+        n += 1
+    return n
+
+
+def longest_match(data, pos, chains):
+    """(length, distance) of the longest earlier match, via 3-byte hash chains."""
+    best_len, best_dist = 0, 0
+    if pos + MATCH_MIN > len(data):
+        return best_len, best_dist
+    limit = min(len(data) - pos, MATCH_MAX)
+    for cand in reversed(chains.get(bytes(data[pos:pos + 3]), [])):
+        dist = pos - cand
+        if dist > WINDOW:
+            break
+        n = 0
+        while n < limit and data[cand + n] == data[pos + n]:
+            n += 1
+        if n > best_len:
+            best_len, best_dist = n, dist
+            if n == limit:
+                break
+    return best_len, best_dist
+
+
+def compress(data):
+    out = bytearray()
+    literals = bytearray()
+    chains = {}
+    pos = 0
+
+    def flush_literals():
+        for i in range(0, len(literals), LITERAL_MAX):
+            chunk = literals[i:i + LITERAL_MAX]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        literals.clear()
+
+    def index(start, end):
+        for i in range(start, min(end, len(data) - 2)):
+            chains.setdefault(bytes(data[i:i + 3]), []).append(i)
+
+    while pos < len(data):
+        fill = run_length(data, pos)
+        match_len, match_dist = longest_match(data, pos, chains)
+
+        # A fill costs 2 bytes, a match 3: take a fill unless a match is longer
+        if fill >= FILL_MIN and fill >= match_len:
+            flush_literals()
+            out.append(0x80 | (fill - FILL_MIN))
+            out.append(data[pos])
+            step = fill
+        elif match_len >= MATCH_MIN:
+            flush_literals()
+            d = match_dist - 1
+            out.append(0xC0 | (match_len - MATCH_MIN))
+            out.append(d & 0xFF)
+            out.append(d >> 8)
+            step = match_len
+        else:
+            literals.append(data[pos])
+            step = 1
+
+        index(pos, pos + step)
+        pos += step
+
+    flush_literals()
+    return bytes(out)
+
+
+def decompress(stream, size):
+    """Reference decoder matching data_lz_unpack(), used for self-checking."""
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        token = stream[i]
+        i += 1
+        if token < 0x80:
+            n = token + 1
+            out.extend(stream[i:i + n])
+            i += n
+        elif token < 0xC0:
+            out.extend(bytes([stream[i]]) * ((token & 0x3F) + FILL_MIN))
+            i += 1
+        else:
+            n = (token & 0x3F) + MATCH_MIN
+            src = len(out) - (stream[i] | (stream[i + 1] << 8)) - 1
+            i += 2
+            for k in range(n):
+                out.append(out[src + k])
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compress a .data load image")
+    parser.add_argument("raw", help="raw .data image")
+    parser.add_argument("packed", help="compressed output")
+    args = parser.parse_args()
+
+    with open(args.raw, "rb") as f:
+        data = f.read()
+
+    packed = compress(data)
+    if decompress(packed, len(data)) != data:
+        sys.exit("pack_data: round-trip check failed")
+
+    with open(args.packed, "wb") as f:
+        f.write(packed)
+
+    saved = len(data) - len(packed)
+    print(f".data: {len(data)} bytes -> {len(packed)} bytes compressed "
+          f"({saved} bytes of flash saved)")
+
+
+if __name__ == "__main__":
+    main()
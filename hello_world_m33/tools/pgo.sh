@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# Profile-Guided Optimization in Renode
+# Builds hello_world_m33.elf instrumented (PGO=generate), runs it headless
+# in Renode until it has dumped its counters over the UART, turns the dump
+# into .gcda files with gcov-tool and rebuilds with -fprofile-use (PGO=use).
+# Extra make options (e.g. DEFINES or FLOAT_ABI) are passed to both builds.
+#
+# Usage: tools/pgo.sh [seconds of virtual time] [make options...]
+
+cd "$(dirname "$0")/.." || exit 1
+
+SECONDS_TO_RUN=${1:-110}
+shift
+GCOV_TOOL=${GCOV_TOOL:-arm-none-eabi-gcov-tool}
+
+if ! command -v renode &> /dev/null; then
+    echo "Error: Renode not found!"
+    exit 1
+fi
+
+# merge-stream adds to existing counters, so start from nothing
+rm -f *.gcda pgo_stream.bin
+
+echo "Building instrumented image..."
+if ! make -s PGO=generate "$@" all > /dev/null; then
+    echo "Error: instrumented build failed"
+    exit 1
+fi
+
+echo "Running the workload for $SECONDS_TO_RUN s of virtual time..."
+rm -f uart_output.log
+renode --disable-xwt --console --plain \
+    -e "include @platform_startup_m33.resc; runMacro \$fast_forward; emulation RunFor \"$SECONDS_TO_RUN\"; quit" \
+    > /dev/null 2>&1
+
+python3 tools/pgo_extract.py uart_output.log pgo_stream.bin || exit 1
+"$GCOV_TOOL" merge-stream pgo_stream.bin || exit 1
+
+echo "Rebuilding with the profile..."
+make PGO=use "$@" all
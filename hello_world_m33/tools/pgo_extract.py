@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""
+Extract the profile dump of a PGO_GENERATE build from a UART capture.
+
+pgo_dump() (see pgo.h) writes one hex line per object file between a
+"gcov begin" and a "gcov end" line. This joins them back into the binary
+gcda stream read by "gcov-tool merge-stream", which writes the .gcda
+files next to the objects for the -fprofile-use rebuild.
+
+Usage:
+    tools/pgo_extract.py uart_output.log pgo_stream.bin
+"""
+
+import argparse
+import sys
+
+
+def extract(lines):
+    """Bytes of the last complete dump in lines, or None if there is none."""
+    stream = None
+    current = None
+    for line in lines:
+        line = line.strip()
+        if line == "gcov begin":
+            current = bytearray()
+        elif line == "gcov end":
+            if current is not None:
+                stream = bytes(current)
+            current = None
+        elif current is not None and line:
+            try:
+                current += bytes.fromhex(line)
+            except ValueError:
+                sys.exit(f"pgo_extract: corrupt dump line: {line[:40]}...")
+    return stream
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Extract a gcda stream from a UART log")
+    parser.add_argument("log", help="UART capture (uart_output.log)")
+    parser.add_argument("stream", help="binary gcda stream output")
+    args = parser.parse_args()
+
+    with open(args.log, "r", encoding="latin-1") as f:
+        stream = extract(f)
+
+    if stream is None:
+        sys.exit("pgo_extract: no complete profile dump in the log "
+                 "(run the instrumented image longer: PGO_SECONDS)")
+
+    with open(args.stream, "wb") as f:
+        f.write(stream)
+
+    print(f"Profile stream: {len(stream)} bytes")
+
+
+if __name__ == "__main__":
+    main()
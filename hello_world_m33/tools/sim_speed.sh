@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Simulation Speed Measurement
+# Runs hello_world_m33.elf headless in Renode for a fixed amount of virtual
+# time and reports simulated seconds per wall-clock second for:
+#   busy delay    - baseline built with -DBUSY_DELAY, which spins on nops
+#                   between messages like the original delay() loop
+#                   (fast-forward enabled; it never finds the core idle)
+#   paced         - tickless WFI idle, paced against the host clock
+#   fast-forward  - tickless WFI idle with idle time skipped
+# Rebuilds the image for the baseline and leaves the default build behind.
+#
+# Usage: tools/sim_speed.sh [virtual-seconds]
+
+SIM_SECONDS=${1:-30}
+
+cd "$(dirname "$0")/.." || exit 1
+
+if ! command -v renode &> /dev/null; then
+    echo "Error: Renode not found!"
+    exit 1
+fi
+
+# Wall-clock seconds for a run of $1 virtual seconds; $2 is an extra monitor command
+run_for() {
+    local start end
+    start=$(date +%s.%N)
+    renode --disable-xwt --console --plain \
+        -e "include @platform_startup_m33.resc; $2; emulation RunFor \"$1\"; quit" \
+        > /dev/null 2>&1
+    end=$(date +%s.%N)
+    echo "$end - $start" | bc -l
+}
+
+echo "Simulating $SIM_SECONDS s of virtual time..."
+
+# Build with make -s, leaving only the linker's memory table on stdout
+build() {
+    if ! make -s "$@" all > /dev/null; then
+        echo "Error: build failed (make $*)"
+        exit 1
+    fi
+}
+
+build DEFINES=-DBUSY_DELAY
+
+# Renode start-up and shutdown cost, subtracted from every run
+overhead=$(run_for 0 "")
+busy=$(echo "$(run_for "$SIM_SECONDS" "runMacro \$fast_forward") - $overhead" | bc -l)
+
+build
+paced=$(echo "$(run_for "$SIM_SECONDS" "") - $overhead" | bc -l)
+fast=$(echo "$(run_for "$SIM_SECONDS" "runMacro \$fast_forward") - $overhead" | bc -l)
+
+printf "Renode start-up overhead: %.2f s (excluded)\n" "$overhead"
+printf "%-16s %10s %14s\n" "mode" "wall [s]" "sim s / wall s"
+printf "%-16s %10.2f %14.2f\n" "busy delay" "$busy" "$(echo "$SIM_SECONDS / $busy" | bc -l)"
+printf "%-16s %10.2f %14.2f\n" "paced" "$paced" "$(echo "$SIM_SECONDS / $paced" | bc -l)"
+printf "%-16s %10.2f %14.2f\n" "fast-forward" "$fast" "$(echo "$SIM_SECONDS / $fast" | bc -l)"
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""
+Function ranking from a Renode execution trace.
+
+Counts the program counters recorded by "cpu CreateExecutionTracing ... PC",
+attributes them to the functions of the firmware ELF, prints the ranking and
+writes a linker script fragment that lists the executed flash functions
+hottest first. linker_m33.ld INCLUDEs the fragment at the start of .text,
+so hot code is contiguous; everything never executed follows it.
+
+Usage:
+    tools/trace_rank.py hello_world_m33.elf trace.log text_hot.ld
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+from log_decode import Elf32
+
+STT_FUNC = 2
+
+
+def functions(elf):
+    """Sorted (start, end, name) of every sized function symbol."""
+    symtab = elf.section_bytes(".symtab")
+    strtab = elf.section_bytes(".strtab")
+    funcs = {}
+    for off in range(0, len(symtab), 16):
+        name, value, size, info, _other, _shndx = struct.unpack_from("<IIIBBH", symtab, off)
+        if info & 0xF != STT_FUNC or size == 0:
+            continue
+        start = value & ~1
+        funcs[start] = (start, start + size, strtab[name:strtab.index(b"\0", name)].decode())
+    return sorted(funcs.values())
+
+
+def count_pcs(path):
+    """Occurrences of each traced PC (first hex field of every line)."""
+    pcs = collections.Counter()
+    with open(path, errors="replace") as f:
+        for line in f:
+            field = line.split(None, 1)
+            if field and field[0].startswith("0x"):
+                try:
+                    pcs[int(field[0].rstrip(":"), 16)] += 1
+                except ValueError:
+                    pass
+    return pcs
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Rank functions by Renode trace hits")
+    parser.add_argument("elf", help="firmware ELF")
+    parser.add_argument("trace", help="Renode execution trace (PC format)")
+    parser.add_argument("fragment", help="linker script fragment to write")
+    parser.add_argument("--top", type=int, default=20, help="rows of the printed ranking")
+    args = parser.parse_args()
+
+    elf = Elf32(args.elf)
+    funcs = functions(elf)
+    starts = [f[0] for f in funcs]
+    _type, _flags, text_start, _offset, text_size = elf.sections[".text"]
+
+    hits = collections.Counter()
+    total = 0
+    for pc, n in count_pcs(args.trace).items():
+        total += n
+        i = bisect.bisect_right(starts, pc) - 1
+        if i >= 0 and pc < funcs[i][1]:
+            hits[funcs[i]] += n
+
+    if not total:
+        sys.exit(f"trace_rank: no PCs found in {args.trace}")
+
+    ranked = hits.most_common()
+    print(f"{'hits':>12} {'share':>7}  function")
+    for (start, _end, name), n in ranked[:args.top]:
+        print(f"{n:12d} {100.0 * n / total:6.2f}%  {name} @ 0x{start:08x}")
+
+    # Only functions linked into flash .text can be reordered there;
+    # .ramfunc code and startup assembly keep their places
+    hot = [(name, n) for (start, _end, name), n in ranked
+           if text_start <= start < text_start + text_size]
+
+    with open(args.fragment, "w") as f:
+        f.write("/* Hot functions, most executed first. Generated by tools/trace_rank.py\n"
+                " * from a Renode execution trace; regenerate with \"make trace-order\". */\n")
+        # GCC places main in .text.startup.main at -O2 and above, and
+        # profile-guided builds use .text.hot. and .text.unlikely. prefixes
+        for name, n in hot:
+            f.write(f"*(.text.{name} .text.startup.{name} .text.hot.{name} "
+                    f".text.unlikely.{name})    /* {n} */\n")
+
+    print(f"{len(hot)} hot functions written to {args.fragment} "
+          f"({len(funcs) - len(hot)} never executed or outside .text)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,73 @@
+/*
+ * TrustZone Non-Secure Application
+ * Has no access to the UART: all output goes through the secure gateways.
+ * Measures the cost of one gateway transition and compares one call per
+ * operation with tz_batch().
+ */
+
+#include <stdint.h>
+#include "tz_gateway.h"
+#include "../cortex_m33.h"
+
+#define BENCH_CALLS     256
+#define BENCH_OPS       TZ_BATCH_MAX
+
+static void ns_puts(const char* str) {
+    const char* end = str;
+
+    while (*end) {
+        end++;
+    }
+    tz_uart_write(str, (uint32_t)(end - str));
+}
+
+/* Print "label value\r\n" with three gateway calls */
+static void ns_report(const char* label, uint32_t value) {
+    ns_puts(label);
+    tz_uart_u32(value);
+    ns_puts("\r\n");
+}
+
+int main(void) {
+    static const char mark[] = "#";
+    tz_batch_t batch = { .count = 0 };
+    uint32_t start;
+    uint32_t nop_cycles;
+    uint32_t single_cycles;
+    uint32_t batch_cycles;
+
+    ns_puts("Non-secure application running\r\n");
+
+    /* One empty gateway round trip */
+    start = dwt_cycles();
+    for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+        tz_nop();
+    }
+    nop_cycles = (dwt_cycles() - start) / BENCH_CALLS;
+
+    /* The same output as one gateway call per operation ... */
+    start = dwt_cycles();
+    for (uint32_t i = 0; i < BENCH_OPS; i++) {
+        tz_uart_write(mark, 1);
+    }
+    single_cycles = dwt_cycles() - start;
+    ns_puts("\r\n");
+
+    /* ... and as one batched call */
+    start = dwt_cycles();
+    for (uint32_t i = 0; i < BENCH_OPS; i++) {
+        tz_batch_write(&batch, mark, 1);
+    }
+    tz_batch_flush(&batch);
+    batch_cycles = dwt_cycles() - start;
+    ns_puts("\r\n");
+
+    ns_puts("TrustZone gateway bench (DWT cycles)\r\n");
+    ns_report("  empty gateway call:          ", nop_cycles);
+    ns_report("  32 writes, one call each:    ", single_cycles);
+    ns_report("  32 writes, one tz_batch():   ", batch_cycles);
+
+    while (1) {
+        cpu_wfi();
+    }
+}
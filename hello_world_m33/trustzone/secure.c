@@ -0,0 +1,126 @@
+/*
+ * TrustZone Secure Image
+ * Owns the UART and everything not explicitly given away. The SAU splits
+ * flash and SRAM in half: the upper halves are non-secure, and the last
+ * 4 KB of secure flash holds the NSC veneers (.gnu.sgstubs). The secure
+ * image initializes the UART, configures the SAU and jumps to the
+ * non-secure reset handler, after which it only runs in gateway calls and
+ * its own interrupt handlers.
+ */
+
+#include <arm_cmse.h>
+#include <stdint.h>
+#include "tz_gateway.h"
+#include "../uart_pl011.h"
+#include "../numfmt.h"
+#include "../cortex_m33.h"
+
+/* Security Attribution Unit */
+#define SAU_CTRL        (*(volatile uint32_t*)0xE000EDD0)   /* Control */
+#define SAU_RNR         (*(volatile uint32_t*)0xE000EDD8)   /* Region Number */
+#define SAU_RBAR        (*(volatile uint32_t*)0xE000EDDC)   /* Region Base Address */
+#define SAU_RLAR        (*(volatile uint32_t*)0xE000EDE0)   /* Region Limit Address */
+#define SAU_CTRL_ENABLE (1u << 0)
+#define SAU_RLAR_ENABLE (1u << 0)
+#define SAU_RLAR_NSC    (1u << 1)                           /* Non-secure callable */
+
+/* Non-secure alias of the vector table offset register */
+#define SCB_NS_VTOR     (*(volatile uint32_t*)0xE002ED08)
+
+/* Memory split (must match linker_secure.ld and linker_ns.ld) */
+#define NSC_BASE        0x0007F000u
+#define NSC_LIMIT       0x0007FFFFu
+#define NS_FLASH_BASE   0x00080000u
+#define NS_FLASH_LIMIT  0x000FFFFFu
+#define NS_SRAM_BASE    0x20020000u
+#define NS_SRAM_LIMIT   0x2003FFFFu
+
+typedef void (*ns_entry_t)(void) __attribute__((cmse_nonsecure_call));
+
+/* Function prototype for SystemInit */
+void SystemInit(void);
+
+void SystemInit(void) {
+    /* The non-secure benchmark reads the DWT cycle counter */
+    dwt_cycle_counter_enable();
+}
+
+static void sau_region(uint32_t n, uint32_t base, uint32_t limit, uint32_t flags) {
+    SAU_RNR = n;
+    SAU_RBAR = base & ~0x1Fu;
+    SAU_RLAR = (limit & ~0x1Fu) | flags | SAU_RLAR_ENABLE;
+}
+
+/* Accept a non-secure buffer only if the caller may read all of it */
+static int tz_readable(const void* buf, uint32_t len) {
+    return len == 0 || cmse_check_address_range((void*)buf, len, CMSE_NONSECURE | CMSE_MPU_READ) != 0;
+}
+
+TZ_ENTRY int32_t tz_nop(void) {
+    return 0;
+}
+
+TZ_ENTRY int32_t tz_uart_write(const void* buf, uint32_t len) {
+    if (!tz_readable(buf, len)) {
+        return -1;
+    }
+    uart_write(buf, len);
+    return 0;
+}
+
+TZ_ENTRY int32_t tz_uart_u32(uint32_t value) {
+    uart_put_number(value);
+    return 0;
+}
+
+TZ_ENTRY int32_t tz_batch(const tz_op_t* ops, uint32_t count) {
+    uint32_t done;
+
+    if (count > TZ_BATCH_MAX || !tz_readable(ops, count * sizeof(*ops))) {
+        return -1;
+    }
+
+    for (done = 0; done < count; done++) {
+        /* Validate and use the same copy of the operation */
+        tz_op_t op = ops[done];
+        char buf[NUMFMT_U32_MAX];
+
+        if (op.op == TZ_OP_WRITE && tz_readable((const void*)op.arg0, op.arg1)) {
+            uart_queue((const void*)op.arg0, op.arg1);
+        } else if (op.op == TZ_OP_U32) {
+            uart_queue(buf, numfmt_u32(buf, op.arg0));
+        } else {
+            break;
+        }
+    }
+
+    uart_tx_start();
+    return (int32_t)done;
+}
+
+int main(void) {
+    const uint32_t* ns_vectors = (const uint32_t*)NS_FLASH_BASE;
+    ns_entry_t ns_reset;
+    uint32_t ns_msp = ns_vectors[0];
+
+    uart_init();
+    uart_puts("Secure image: UART is secure, starting the non-secure application\n");
+
+    /* Non-secure flash and SRAM, plus the NSC veneer window */
+    sau_region(0, NS_FLASH_BASE, NS_FLASH_LIMIT, 0);
+    sau_region(1, NSC_BASE, NSC_LIMIT, SAU_RLAR_NSC);
+    sau_region(2, NS_SRAM_BASE, NS_SRAM_LIMIT, 0);
+    SAU_CTRL = SAU_CTRL_ENABLE;
+    cpu_barrier();
+
+    /* Hand over: non-secure vector table, stack and reset handler */
+    SCB_NS_VTOR = NS_FLASH_BASE;
+    __asm__ volatile ("msr msp_ns, %0" :: "r" (ns_msp));
+    ns_reset = (ns_entry_t)cmse_nsfptr_create(ns_vectors[1]);
+    ns_reset();
+
+    /* The non-secure application never returns */
+    while (1) {
+        cpu_wfi();
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * TrustZone Gateway Interface
+ * Entry points that the secure image exports to the non-secure application
+ * through non-secure callable (NSC) veneers. Every call costs a pair of
+ * security state transitions (SG on entry, BXNS on return) plus the
+ * register clearing the compiler adds on both sides, so output should be
+ * batched: tz_batch() executes up to TZ_BATCH_MAX operations per call.
+ */
+
+#ifndef TZ_GATEWAY_H
+#define TZ_GATEWAY_H
+
+#include <stdint.h>
+
+/* The secure image is compiled with -mcmse and defines the entry points */
+#if defined(__ARM_FEATURE_CMSE) && (__ARM_FEATURE_CMSE & 2)
+#define TZ_ENTRY __attribute__((cmse_nonsecure_entry))
+#else
+#define TZ_ENTRY
+#endif
+
+/* Largest number of operations accepted by one tz_batch() call */
+#define TZ_BATCH_MAX    32
+
+/* Batched operations */
+#define TZ_OP_WRITE     1u      /* arg0 = buffer, arg1 = length */
+#define TZ_OP_U32       2u      /* arg0 = value printed as decimal */
+
+typedef struct {
+    uint32_t op;
+    uint32_t arg0;
+    uint32_t arg1;
+} tz_op_t;
+
+/* Empty gateway, for measuring the cost of a transition */
+TZ_ENTRY int32_t tz_nop(void);
+
+/* Queue len raw bytes of non-secure memory on the secure UART.
+ * Returns 0, or -1 if the buffer is not non-secure readable. */
+TZ_ENTRY int32_t tz_uart_write(const void* buf, uint32_t len);
+
+/* Print a number as decimal on the secure UART */
+TZ_ENTRY int32_t tz_uart_u32(uint32_t value);
+
+/* Execute count operations in one transition and start transmission once.
+ * Returns the number executed: fewer than count if an operation was
+ * rejected, -1 if the array itself is not non-secure readable. */
+TZ_ENTRY int32_t tz_batch(const tz_op_t* ops, uint32_t count);
+
+/* Non-secure side batch builder. Buffers of queued writes must stay valid
+ * until tz_batch_flush(). */
+typedef struct {
+    tz_op_t ops[TZ_BATCH_MAX];
+    uint32_t count;
+} tz_batch_t;
+
+static inline int32_t tz_batch_flush(tz_batch_t* batch) {
+    int32_t done = batch->count ? tz_batch(batch->ops, batch->count) : 0;
+
+    batch->count = 0;
+    return done;
+}
+
+static inline void tz_batch_add(tz_batch_t* batch, uint32_t op, uint32_t arg0, uint32_t arg1) {
+    if (batch->count == TZ_BATCH_MAX) {
+        tz_batch_flush(batch);
+    }
+    batch->ops[batch->count].op = op;
+    batch->ops[batch->count].arg0 = arg0;
+    batch->ops[batch->count].arg1 = arg1;
+    batch->count++;
+}
+
+static inline void tz_batch_write(tz_batch_t* batch, const void* buf, uint32_t len) {
+    tz_batch_add(batch, TZ_OP_WRITE, (uint32_t)buf, len);
+}
+
+static inline void tz_batch_u32(tz_batch_t* batch, uint32_t value) {
+    tz_batch_add(batch, TZ_OP_U32, value, 0);
+}
+
+#endif /* TZ_GATEWAY_H */
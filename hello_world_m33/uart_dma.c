@@ -0,0 +1,138 @@
+/*
+ * DMA-Driven UART Transmit
+ * The PL011 model has no DMA request line, so the stream runs in
+ * memory-to-memory mode: the source (PAR) walks the buffer and the
+ * destination (M0AR) stays fixed on the UART data register. The Renode
+ * PL011 accepts data as fast as it is written; on silicon the stream would
+ * be paced by UARTTXDMABREQ in memory-to-peripheral mode instead.
+ */
+
+#include "uart_dma.h"
+#include "uart_pl011.h"
+#include "cortex_m33.h"
+#include "irq.h"
+#include "ramfunc.h"
+
+/* STM32 DMA Register Definitions (stream 0 only) */
+#define DMA_BASE        BOARD_DMA_BASE
+
+#define DMA_LISR        (*(volatile uint32_t*)(DMA_BASE + 0x00))    /* Low Interrupt Status */
+#define DMA_LIFCR       (*(volatile uint32_t*)(DMA_BASE + 0x08))    /* Low Interrupt Flag Clear */
+#define DMA_S0CR        (*(volatile uint32_t*)(DMA_BASE + 0x10))    /* Stream 0 Configuration */
+#define DMA_S0NDTR      (*(volatile uint32_t*)(DMA_BASE + 0x14))    /* Stream 0 Number of Data */
+#define DMA_S0PAR       (*(volatile uint32_t*)(DMA_BASE + 0x18))    /* Stream 0 Peripheral Address */
+#define DMA_S0M0AR      (*(volatile uint32_t*)(DMA_BASE + 0x1C))    /* Stream 0 Memory Address */
+
+/* Stream 0 flags in LISR / LIFCR */
+#define DMA_S0_TEIF     (1 << 3)    /* Transfer error */
+#define DMA_S0_TCIF     (1 << 5)    /* Transfer complete */
+#define DMA_S0_FLAGS    0x3Du       /* FEIF, DMEIF, TEIF, HTIF, TCIF */
+
+/* Stream configuration bits */
+#define DMA_CR_EN       (1 << 0)    /* Stream enable */
+#define DMA_CR_TEIE     (1 << 2)    /* Transfer error interrupt enable */
+#define DMA_CR_TCIE     (1 << 4)    /* Transfer complete interrupt enable */
+#define DMA_CR_DIR_M2M  (2 << 6)    /* Memory-to-memory: PAR -> M0AR */
+#define DMA_CR_PINC     (1 << 9)    /* Increment the source (PAR) */
+
+/* Transfer state, owned by the ISR while a transfer is in flight */
+static const uint8_t* dma_next;
+static uint32_t dma_left;
+static uart_dma_done_t dma_done;
+static volatile int dma_active;
+
+/* Program and enable the stream for the next segment of the buffer */
+static void uart_dma_start_segment(void) {
+    uint32_t len = dma_left > UART_DMA_MAX_SEGMENT ? UART_DMA_MAX_SEGMENT : dma_left;
+
+    /* The stream only accepts a new configuration while disabled */
+    DMA_S0CR = 0;
+    while (DMA_S0CR & DMA_CR_EN) {
+    }
+    DMA_LIFCR = DMA_S0_FLAGS;
+
+    DMA_S0PAR = (uint32_t)dma_next;
+    DMA_S0M0AR = UART_DR_ADDR;
+    DMA_S0NDTR = len;
+    dma_next += len;
+    dma_left -= len;
+
+    /* Byte transfers (PSIZE = MSIZE = 0), fixed destination */
+    DMA_S0CR = DMA_CR_DIR_M2M | DMA_CR_PINC | DMA_CR_TCIE | DMA_CR_TEIE | DMA_CR_EN;
+}
+
+void uart_dma_init(void) {
+    DMA_S0CR = 0;
+    DMA_LIFCR = DMA_S0_FLAGS;
+    dma_active = 0;
+
+    /* Installed straight into the SRAM vector table, no trampoline */
+    irq_register(UART_DMA_IRQn, DMA_Stream0_Handler);
+
+    /* Same priority as the UART so neither preempts the other */
+    nvic_set_priority(UART_DMA_IRQn, 0x80);
+    nvic_enable_irq(UART_DMA_IRQn);
+}
+
+int uart_dma_write(const void* buf, uint32_t len, uart_dma_done_t done) {
+    if (dma_active) {
+        return -1;
+    }
+    if (len == 0) {
+        if (done) {
+            done();
+        }
+        return 0;
+    }
+
+    /* Let CPU-queued output leave first so the streams never interleave */
+    uart_flush();
+
+    dma_next = (const uint8_t*)buf;
+    dma_left = len;
+    dma_done = done;
+    dma_active = 1;
+    uart_dma_start_segment();
+    return 0;
+}
+
+int uart_dma_busy(void) {
+    return dma_active;
+}
+
+void uart_dma_wait(void) {
+    while (dma_active) {
+        uint32_t primask = irq_save();
+        if (dma_active) {
+            /* Woken by the completion interrupt */
+            cpu_wfi();
+        }
+        irq_restore(primask);
+    }
+}
+
+/* Stream 0 interrupt: chain the next segment or report completion */
+RAMFUNC
+void DMA_Stream0_Handler(void) {
+    uint32_t lisr = DMA_LISR;
+
+    DMA_LIFCR = DMA_S0_FLAGS;
+
+    if (lisr & DMA_S0_TEIF) {
+        /* Bus error: abandon the rest of the buffer */
+        dma_left = 0;
+    } else if (!(lisr & DMA_S0_TCIF)) {
+        return;
+    }
+
+    if (dma_left) {
+        uart_dma_start_segment();
+        return;
+    }
+
+    DMA_S0CR = 0;
+    dma_active = 0;
+    if (dma_done) {
+        dma_done();
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * DMA-Driven UART Transmit
+ * Hands whole buffers to the PL011 through stream 0 of the STM32-style DMA
+ * controller (BOARD_DMA_BASE) and reports completion from its interrupt, so
+ * large dumps cost the CPU only the few register writes that start them.
+ */
+
+#ifndef UART_DMA_H
+#define UART_DMA_H
+
+#include <stdint.h>
+#include "board_config.h"
+
+/* NVIC interrupt line of DMA stream 0 ("dma 0 -> nvic@N" in cortex_m33_platform.repl) */
+#define UART_DMA_IRQn       BOARD_DMA_IRQ
+
+/* Longest transfer a single stream programming can move (16-bit NDTR).
+ * Longer buffers are sent as consecutive segments by the interrupt. */
+#define UART_DMA_MAX_SEGMENT 0xFFFFu
+
+/* Called from the DMA interrupt once the whole buffer has been sent */
+typedef void (*uart_dma_done_t)(void);
+
+/* Reset the stream and enable its interrupt in the NVIC */
+void uart_dma_init(void);
+
+/* Start sending len raw bytes (no newline conversion). The buffer must stay
+ * untouched until done runs (done may be null). Output already queued with
+ * uart_write()/uart_printf() is flushed first so the two paths never
+ * interleave; do not queue more UART output until the transfer completes.
+ * Returns 0 once started, -1 if a transfer is still in flight. */
+int uart_dma_write(const void* buf, uint32_t len, uart_dma_done_t done);
+
+/* Nonzero while a transfer is in flight */
+int uart_dma_busy(void);
+
+/* Sleep in WFI until the current transfer (if any) has completed */
+void uart_dma_wait(void);
+
+/* Compare CPU-driven and DMA-driven transmission of a telemetry block */
+void uart_dma_bench(void);
+
+/* DMA stream 0 interrupt handler (installed at run time by uart_dma_init()) */
+void DMA_Stream0_Handler(void);
+
+#endif /* UART_DMA_H */
@@ -0,0 +1,382 @@
+/*
+ * ARM PL011 UART Driver
+ * Characters are queued in a software ring buffer and drained into the
+ * hardware FIFO by the PL011 transmit interrupt, so callers never spin
+ * on the Flag Register. Received characters are drained by the receive
+ * and receive-timeout interrupts into a second ring read with uart_getchar().
+ */
+
+#include "uart_pl011.h"
+#include "cortex_m33.h"
+#include "numfmt.h"
+#include "profile.h"
+#include "ramfunc.h"
+#include "hal_pl011.h"
+
+/* PL011 registers are reached through the HAL accessors at the board's
+ * constant base address, so each access is a single immediate-offset
+ * load or store */
+#define UART_BASE           BOARD_UART_BASE
+
+#define uart_reg_read(reg)          pl011_read(UART_BASE, PL011_##reg)
+#define uart_reg_write(reg, value)  pl011_write(UART_BASE, PL011_##reg, (value))
+
+/* The boot and telemetry rates must be reachable from the UART clock */
+#if !PL011_BAUD_OK(BOARD_CLOCK_UART_HZ, BOARD_CONSOLE_BAUD)
+#error "BOARD_CONSOLE_BAUD cannot be produced from BOARD_CLOCK_UART_HZ"
+#endif
+#if !PL011_BAUD_OK(BOARD_CLOCK_UART_HZ, UART_BAUD_TELEMETRY)
+#error "UART_BAUD_TELEMETRY cannot be produced from BOARD_CLOCK_UART_HZ"
+#endif
+
+#define UART_TX_BUF_MASK    (UART_TX_BUF_SIZE - 1)
+#define UART_RX_BUF_MASK    (UART_RX_BUF_SIZE - 1)
+
+/* Transmit ring buffer: head is written by the producer, tail by the ISR.
+ * Indices run freely and are masked on access, so head - tail is the fill level. */
+static char tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t tx_head;
+static volatile uint32_t tx_tail;
+
+/* Receive ring buffer: single producer (the ISR advances head) and single
+ * consumer (uart_getchar() advances tail), so neither side needs a lock */
+static char rx_buf[UART_RX_BUF_SIZE];
+static volatile uint32_t rx_head;
+static volatile uint32_t rx_tail;
+
+/* Characters dropped because the receive ring was full */
+static volatile uint32_t rx_overruns;
+
+/* Line rate programmed by uart_init() or uart_set_baud() */
+static uint32_t baud_rate;
+
+/* Shadow of the IMSC register so arming/disarming TX costs no MMIO read */
+static uint32_t uart_imsc;
+
+/* Push up to len bytes into the hardware FIFO and return how many were taken.
+ * FR is read once per burst: an empty FIFO accepts a full PL011_FIFO_DEPTH
+ * burst, a non-full one at least a single byte. */
+RAMFUNC
+static uint32_t uart_fifo_write(const char* p, uint32_t len) {
+    uint32_t written = 0;
+
+    while (written < len) {
+        uint32_t fr = uart_reg_read(FR);
+        uint32_t burst;
+
+        if (fr & PL011_FR_TXFE) {
+            burst = PL011_FIFO_DEPTH;
+        } else if (!(fr & PL011_FR_TXFF)) {
+            burst = 1;
+        } else {
+            break;
+        }
+
+        if (burst > len - written) {
+            burst = len - written;
+        }
+        written += burst;
+        while (burst--) {
+            uart_reg_write(DR, (uint8_t)*p++);
+        }
+    }
+
+    return written;
+}
+
+/* Arm or disarm the TX interrupt, touching IMSC only on a change */
+static void uart_tx_irq_enable(int enable) {
+    uint32_t imsc = enable ? (uart_imsc | PL011_INT_TX) : (uart_imsc & ~PL011_INT_TX);
+
+    if (imsc != uart_imsc) {
+        uart_imsc = imsc;
+        uart_reg_write(IMSC, imsc);
+    }
+}
+
+/* Move queued characters into the hardware FIFO until it is full or the
+ * ring is empty, then arm the TX interrupt only if data is still pending.
+ * Must run with the UART interrupt masked (from the ISR or under irq_save). */
+RAMFUNC
+static void uart_tx_fill_fifo(void) {
+    uint32_t tail = tx_tail;
+    uint32_t head = tx_head;
+
+    while (tail != head) {
+        /* Largest contiguous run before the ring wraps */
+        uint32_t offset = tail & UART_TX_BUF_MASK;
+        uint32_t run = head - tail;
+        uint32_t taken;
+
+        if (run > UART_TX_BUF_SIZE - offset) {
+            run = UART_TX_BUF_SIZE - offset;
+        }
+        taken = uart_fifo_write(&tx_buf[offset], run);
+        tail += taken;
+        if (taken < run) {
+            break;
+        }
+    }
+    tx_tail = tail;
+
+    uart_tx_irq_enable(tail != head);
+}
+
+/* Start transmission of newly queued data.
+ * The PL011 TX interrupt is edge-triggered on the FIFO level, so an idle
+ * transmitter must be primed by writing the FIFO directly. */
+static void uart_tx_kick(void) {
+    uint32_t primask = irq_save();
+    uart_tx_fill_fifo();
+    irq_restore(primask);
+}
+
+/* Queue len bytes without starting transmission of the ring.
+ * While the ring is empty the data goes straight into the hardware FIFO;
+ * whatever does not fit is copied into the ring, sleeping while it is full. */
+static void uart_tx_append(const char* p, uint32_t len) {
+    while (len) {
+        uint32_t primask = irq_save();
+        uint32_t head = tx_head;
+        uint32_t space;
+
+        if (head == tx_tail) {
+            uint32_t taken = uart_fifo_write(p, len);
+            p += taken;
+            len -= taken;
+        }
+
+        space = UART_TX_BUF_SIZE - (head - tx_tail);
+        if (len && space == 0) {
+            uart_tx_fill_fifo();
+            if (tx_head - tx_tail == UART_TX_BUF_SIZE) {
+                /* Woken by the TX interrupt once the FIFO drains */
+                cpu_wfi();
+            }
+        }
+        irq_restore(primask);
+
+        /* Only this producer advances head, so the copy runs unlocked */
+        if (space > len) {
+            space = len;
+        }
+        len -= space;
+        while (space--) {
+            tx_buf[head & UART_TX_BUF_MASK] = *p++;
+            head++;
+        }
+        tx_head = head;
+    }
+}
+
+/* Initialize the UART for communication */
+void uart_init(void) {
+    PROFILE_BEGIN(uart_init);
+
+    /* Disable the UART and program 8N1 at the board's console baud rate;
+     * the divisors are constants computed from the board clock model */
+    pl011_configure(UART_BASE, BOARD_CLOCK_UART_HZ, BOARD_CONSOLE_BAUD);
+    baud_rate = BOARD_CONSOLE_BAUD;
+
+    /* Clear all interrupts and leave only receive armed; TX is armed on demand */
+    uart_reg_write(IFLS, PL011_IFLS_TX_1_8 | PL011_IFLS_RX_1_8);
+    uart_reg_write(ICR, PL011_INT_ALL);
+    uart_imsc = PL011_INT_RX | PL011_INT_RT;
+    uart_reg_write(IMSC, uart_imsc);
+
+    tx_head = 0;
+    tx_tail = 0;
+    rx_head = 0;
+    rx_tail = 0;
+    rx_overruns = 0;
+
+    /* Enable UART, transmit, and receive */
+    pl011_enable(UART_BASE);
+
+    /* Route the UART interrupt through the NVIC */
+    nvic_set_priority(UART_IRQn, 0x80);
+    nvic_enable_irq(UART_IRQn);
+
+    PROFILE_END(uart_init);
+}
+
+/* Reprogram the divisors between characters: the PL011 must be disabled
+ * while IBRD, FBRD and LCRH change, and a character still in the shift
+ * register would be cut, so the ring and transmitter are drained first */
+int uart_set_baud(uint32_t baud) {
+    uint32_t primask;
+
+    if (!PL011_BAUD_OK(BOARD_CLOCK_UART_HZ, baud)) {
+        return -1;
+    }
+
+    uart_flush();
+    primask = irq_save();
+    uart_reg_write(CR, 0);
+    pl011_set_divisor(UART_BASE, PL011_IBRD_VALUE(BOARD_CLOCK_UART_HZ, baud),
+                      PL011_FBRD_VALUE(BOARD_CLOCK_UART_HZ, baud));
+    pl011_enable(UART_BASE);
+    baud_rate = baud;
+    irq_restore(primask);
+
+    return 0;
+}
+
+uint32_t uart_baud(void) {
+    return baud_rate;
+}
+
+uint32_t uart_baud_actual(void) {
+    return PL011_BAUD_ACTUAL(BOARD_CLOCK_UART_HZ, baud_rate);
+}
+
+/* Drain the receive FIFO into the ring, dropping characters when it is full */
+RAMFUNC
+static void uart_rx_drain(void) {
+    uint32_t head = rx_head;
+
+    while (!(uart_reg_read(FR) & PL011_FR_RXFE)) {
+        /* DR bits 8..11 carry framing/parity/break/overrun errors; keep the data */
+        char c = (char)uart_reg_read(DR);
+
+        if (head - rx_tail == UART_RX_BUF_SIZE) {
+            rx_overruns = rx_overruns + 1;
+            continue;
+        }
+        rx_buf[head & UART_RX_BUF_MASK] = c;
+        head++;
+    }
+    rx_head = head;
+}
+
+/* UART interrupt handler: empty the receive FIFO, refill the transmit FIFO */
+RAMFUNC
+void UART_Handler(void) {
+    uint32_t mis = uart_reg_read(MIS);
+
+    if (mis & (PL011_INT_RX | PL011_INT_RT)) {
+        uart_reg_write(ICR, PL011_INT_RX | PL011_INT_RT);
+        uart_rx_drain();
+    }
+    if (mis & PL011_INT_TX) {
+        uart_reg_write(ICR, PL011_INT_TX);
+        uart_tx_fill_fifo();
+    }
+}
+
+/* Queue a block of raw bytes and start transmission */
+void uart_write(const void* buf, uint32_t len) {
+    uart_tx_append((const char*)buf, len);
+    uart_tx_kick();
+}
+
+/* Queue raw bytes; transmission of the ring starts at uart_tx_start() */
+void uart_queue(const void* buf, uint32_t len) {
+    uart_tx_append((const char*)buf, len);
+}
+
+/* Queue len characters of text, converting "\n" to "\r\n" */
+void uart_queue_text(const char* str, uint32_t len) {
+    const char* end = str + len;
+    const char* run = str;
+
+    for (; str != end; str++) {
+        if (*str == '\n') {
+            uart_tx_append(run, (uint32_t)(str - run));
+            uart_tx_append("\r\n", 2);
+            run = str + 1;
+        }
+    }
+    uart_tx_append(run, (uint32_t)(end - run));
+}
+
+/* Start transmission of everything queued so far */
+void uart_tx_start(void) {
+    uart_tx_kick();
+}
+
+/* Queue a single character */
+void uart_putchar(char c) {
+    uart_write(&c, 1);
+}
+
+/* Queue a string in runs between line feeds and start transmission once */
+void uart_puts(const char* str) {
+    PROFILE_BEGIN(uart_puts);
+    const char* run = str;
+
+    for (;; str++) {
+        if (*str == '\n' || *str == '\0') {
+            uart_tx_append(run, (uint32_t)(str - run));
+            if (*str == '\0') {
+                break;
+            }
+            /* Convert line feeds to carriage return + line feed */
+            uart_tx_append("\r\n", 2);
+            run = str + 1;
+        }
+    }
+    uart_tx_kick();
+
+    PROFILE_END(uart_puts);
+}
+
+/* Send a number as decimal via UART */
+void uart_put_number(uint32_t num) {
+    char buffer[NUMFMT_U32_MAX];
+
+    uart_write(buffer, numfmt_u32(buffer, num));
+}
+
+/* Wait until the ring is empty and the transmitter has gone idle */
+void uart_flush(void) {
+    while (tx_head != tx_tail) {
+        uint32_t primask = irq_save();
+        uart_tx_fill_fifo();
+        if (tx_head != tx_tail) {
+            cpu_wfi();
+        }
+        irq_restore(primask);
+    }
+
+    while (uart_reg_read(FR) & PL011_FR_BUSY) {
+        /* Wait for the last character to leave the shift register */
+    }
+}
+
+/* Drain the ring, then the caller's bytes, without waiting for the TX interrupt */
+void uart_write_polled(const void* buf, uint32_t len) {
+    const char* p = (const char*)buf;
+
+    while (tx_head != tx_tail) {
+        uart_tx_fill_fifo();
+    }
+    while (len) {
+        uint32_t taken = uart_fifo_write(p, len);
+        p += taken;
+        len -= taken;
+    }
+}
+
+/* Take one received character, or return -1 if none is waiting */
+int uart_getchar(void) {
+    uint32_t tail = rx_tail;
+    char c;
+
+    if (tail == rx_head) {
+        return -1;
+    }
+    c = rx_buf[tail & UART_RX_BUF_MASK];
+    rx_tail = tail + 1;
+    return (uint8_t)c;
+}
+
+/* Number of received characters waiting in the ring */
+uint32_t uart_rx_available(void) {
+    return rx_head - rx_tail;
+}
+
+/* Characters lost to a full receive ring since uart_init() */
+uint32_t uart_rx_overruns(void) {
+    return rx_overruns;
+}
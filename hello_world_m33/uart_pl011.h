@@ -0,0 +1,84 @@
+/*
+ * ARM PL011 UART Driver Interface
+ * Interrupt-driven transmit and receive paths for the Cortex-M33 demo board.
+ */
+
+#ifndef UART_PL011_H
+#define UART_PL011_H
+
+#include <stdint.h>
+#include "board_config.h"
+#include "hal_pl011.h"
+
+/* NVIC interrupt line of the UART ("uart -> nvic@N" in cortex_m33_platform.repl) */
+#define UART_IRQn           BOARD_UART_IRQ
+
+/* Address of the PL011 data register, the target of DMA transfers */
+#define UART_DR_ADDR        (BOARD_UART_BASE + PL011_DR)
+
+/* Faster line rate for telemetry bursts ("set baud"), checked against the
+ * board's UART clock at compile time like the boot rate BOARD_CONSOLE_BAUD */
+#define UART_BAUD_TELEMETRY 921600u
+
+/* Size of the software transmit ring buffer (must be a power of two) */
+#define UART_TX_BUF_SIZE    256
+
+/* Size of the software receive ring buffer (must be a power of two) */
+#define UART_RX_BUF_SIZE    128
+
+/* Initialize the UART at BOARD_CONSOLE_BAUD and enable its interrupt in the NVIC */
+void uart_init(void);
+
+/* Switch the line rate once everything queued has been sent. Returns 0, or
+ * -1 (rate unchanged) if BOARD_CLOCK_UART_HZ cannot produce baud within
+ * PL011_BAUD_TOLERANCE; the ceiling is PL011_BAUD_MAX(BOARD_CLOCK_UART_HZ). */
+int uart_set_baud(uint32_t baud);
+
+/* Current line rate as requested, and as produced by the divisors */
+uint32_t uart_baud(void);
+uint32_t uart_baud_actual(void);
+
+/* Queue a block of raw bytes for transmission (no newline conversion).
+ * The hardware FIFO is filled in bursts of up to 16 bytes per status read. */
+void uart_write(const void* buf, uint32_t len);
+
+/* Queue raw bytes without starting the transmitter. Batches of queued
+ * output are started with a single uart_tx_start() call. */
+void uart_queue(const void* buf, uint32_t len);
+
+/* Queue len characters of text without starting the transmitter,
+ * converting "\n" to "\r\n" */
+void uart_queue_text(const char* str, uint32_t len);
+
+/* Start transmission of everything queued with uart_queue*() */
+void uart_tx_start(void);
+
+/* Queue a single character for transmission */
+void uart_putchar(char c);
+
+/* Queue a string for transmission, converting "\n" to "\r\n" */
+void uart_puts(const char* str);
+
+/* Queue a number as decimal */
+void uart_put_number(uint32_t num);
+
+/* Wait until every queued character has been handed to the hardware */
+void uart_flush(void);
+
+/* Send len raw bytes by polling the Flag Register, after whatever is still
+ * queued in the ring. Needs no interrupts, so it works from fault handlers. */
+void uart_write_polled(const void* buf, uint32_t len);
+
+/* Take one received character without blocking; returns -1 if none is waiting */
+int uart_getchar(void);
+
+/* Number of received characters waiting to be read */
+uint32_t uart_rx_available(void);
+
+/* Characters dropped because the receive ring was full */
+uint32_t uart_rx_overruns(void);
+
+/* PL011 interrupt handler (installed in the vector table by startup_m33.S) */
+void UART_Handler(void);
+
+#endif /* UART_PL011_H */
@@ -0,0 +1,225 @@
+/*
+ * Zero-Allocation Formatted UART Output
+ * Literal runs of the format string are queued directly from flash and
+ * numbers are rendered into a few bytes of stack, so no line buffer or
+ * heap is ever needed. The transmitter is started once per call.
+ */
+
+#include "uart_printf.h"
+#include "numfmt.h"
+
+/* Field flags parsed from a conversion specification */
+#define FMT_LEFT        (1u << 0)   /* '-': left-justify within the field */
+
+/* Largest rendered number body (the sign is queued separately) */
+#define FMT_NUM_MAX     NUMFMT_FIXED_MAX
+
+static const char fmt_spaces[16] = "                ";
+static const char fmt_zeros[16]  = "0000000000000000";
+
+/* Queue count padding characters in runs of up to 16 */
+static void fmt_pad(char pad, uint32_t count) {
+    const char* src = (pad == '0') ? fmt_zeros : fmt_spaces;
+
+    while (count) {
+        uint32_t run = count > sizeof(fmt_spaces) ? sizeof(fmt_spaces) : count;
+        uart_queue(src, run);
+        count -= run;
+    }
+}
+
+/* Queue a rendered field: optional sign, then the body, padded to width.
+ * Zero padding goes between the sign and the digits. */
+static void fmt_field(char sign, const char* body, uint32_t len,
+                      uint32_t width, char pad, uint32_t flags) {
+    uint32_t total = len + (sign ? 1 : 0);
+    uint32_t fill = width > total ? width - total : 0;
+
+    if (!(flags & FMT_LEFT) && pad != '0') {
+        fmt_pad(' ', fill);
+    }
+    if (sign) {
+        uart_queue(&sign, 1);
+    }
+    if (!(flags & FMT_LEFT) && pad == '0') {
+        fmt_pad('0', fill);
+    }
+    uart_queue(body, len);
+    if (flags & FMT_LEFT) {
+        fmt_pad(' ', fill);
+    }
+}
+
+/* Magnitude of a signed value, valid for INT32_MIN as well */
+static uint32_t fmt_abs(int32_t value) {
+    return value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+}
+
+/* Length of a NUL-terminated string */
+static uint32_t fmt_strlen(const char* str) {
+    const char* end = str;
+
+    while (*end) {
+        end++;
+    }
+    return (uint32_t)(end - str);
+}
+
+void uart_fmt_text(const char* str, uint32_t len) {
+    uart_queue_text(str, len);
+}
+
+void uart_fmt_cstr(const char* str) {
+    if (!str) {
+        str = "(null)";
+    }
+    uart_queue_text(str, fmt_strlen(str));
+}
+
+void uart_fmt_u32(uint32_t value, uint32_t width, char pad) {
+    char buf[FMT_NUM_MAX];
+
+    fmt_field(0, buf, numfmt_u32(buf, value), width, pad, 0);
+}
+
+void uart_fmt_i32(int32_t value, uint32_t width, char pad) {
+    char buf[FMT_NUM_MAX];
+
+    fmt_field(value < 0 ? '-' : 0, buf, numfmt_u32(buf, fmt_abs(value)), width, pad, 0);
+}
+
+void uart_fmt_hex(uint32_t value, uint32_t width, char pad) {
+    char buf[FMT_NUM_MAX];
+
+    fmt_field(0, buf, numfmt_hex32(buf, value, numfmt_hex_lower), width, pad, 0);
+}
+
+void uart_fmt_fixed(int32_t value, uint32_t frac_digits) {
+    char buf[FMT_NUM_MAX];
+
+    /* Same limit as %k: more digits than Q16.16 carries would overrun buf */
+    if (frac_digits > 9) {
+        frac_digits = 9;
+    }
+    fmt_field(value < 0 ? '-' : 0, buf, numfmt_ufixed32(buf, fmt_abs(value), frac_digits), 0, ' ', 0);
+}
+
+void uart_vprintf(const char* fmt, va_list ap) {
+    while (*fmt) {
+        const char* run = fmt;
+        char buf[FMT_NUM_MAX];
+        uint32_t len;
+        char sign = 0;
+        char pad = ' ';
+        uint32_t flags = 0;
+        uint32_t width = 0;
+        uint32_t precision = 0;
+
+        /* Queue the literal run up to the next conversion in one piece */
+        while (*fmt && *fmt != '%') {
+            fmt++;
+        }
+        if (fmt != run) {
+            uart_queue_text(run, (uint32_t)(fmt - run));
+        }
+        if (!*fmt) {
+            break;
+        }
+        fmt++;
+
+        /* Flags, field width and precision */
+        for (;; fmt++) {
+            if (*fmt == '-') {
+                flags |= FMT_LEFT;
+            } else if (*fmt == '0') {
+                pad = '0';
+            } else {
+                break;
+            }
+        }
+        while (*fmt >= '0' && *fmt <= '9') {
+            width = width * 10 + (uint32_t)(*fmt++ - '0');
+        }
+        if (*fmt == '.') {
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9') {
+                precision = precision * 10 + (uint32_t)(*fmt++ - '0');
+            }
+        }
+        if (flags & FMT_LEFT) {
+            pad = ' ';
+        }
+
+        switch (*fmt) {
+        case 'u':
+            len = numfmt_u32(buf, va_arg(ap, uint32_t));
+            break;
+        case 'd':
+        case 'i': {
+            int32_t value = va_arg(ap, int32_t);
+            sign = value < 0 ? '-' : 0;
+            len = numfmt_u32(buf, fmt_abs(value));
+            break;
+        }
+        case 'x':
+            len = numfmt_hex32(buf, va_arg(ap, uint32_t), numfmt_hex_lower);
+            break;
+        case 'X':
+            len = numfmt_hex32(buf, va_arg(ap, uint32_t), numfmt_hex_upper);
+            break;
+        case 'k': {
+            int32_t value = va_arg(ap, int32_t);
+            sign = value < 0 ? '-' : 0;
+            len = numfmt_ufixed32(buf, fmt_abs(value), precision > 9 ? 9 : precision);
+            break;
+        }
+        case 'c':
+            buf[0] = (char)va_arg(ap, int);
+            len = 1;
+            break;
+        case 's': {
+            const char* str = va_arg(ap, const char*);
+            uint32_t str_len;
+            uint32_t fill;
+
+            if (!str) {
+                str = "(null)";
+            }
+            str_len = fmt_strlen(str);
+            fill = width > str_len ? width - str_len : 0;
+
+            /* Strings may contain line feeds, so they bypass fmt_field() */
+            if (!(flags & FMT_LEFT)) {
+                fmt_pad(' ', fill);
+            }
+            uart_queue_text(str, str_len);
+            if (flags & FMT_LEFT) {
+                fmt_pad(' ', fill);
+            }
+            fmt++;
+            continue;
+        }
+        case '%':
+            buf[0] = '%';
+            len = 1;
+            break;
+        default:
+            /* Unknown or truncated conversion: stop formatting */
+            uart_tx_start();
+            return;
+        }
+
+        fmt_field(sign, buf, len, width, pad, flags);
+        fmt++;
+    }
+
+    uart_tx_start();
+}
+
+void uart_printf(const char* fmt, ...) {
+    va_list ap;
+
+    va_start(ap, fmt);
+    uart_vprintf(fmt, ap);
+    va_end(ap);
+}
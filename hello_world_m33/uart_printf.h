@@ -0,0 +1,54 @@
+/*
+ * Zero-Allocation Formatted UART Output
+ * printf-style formatting rendered straight into the PL011 TX path,
+ * plus compile-time specialized building blocks for hot log lines.
+ */
+
+#ifndef UART_PRINTF_H
+#define UART_PRINTF_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include "uart_pl011.h"
+
+/*
+ * Format and queue output, converting "\n" to "\r\n".
+ * Supported conversions: %u %d %x %X %c %s %% and the fixed-point %k.
+ * Flags: '-' (left-justify) and '0' (zero pad), followed by a field width.
+ * %.Nk prints a signed 32-bit value scaled by 10^N, e.g.
+ * uart_printf("%.3k V", 3300) prints "3.300 V"; N (like the digits of
+ * FMT_FIXED) is limited to 9. A null %s argument prints "(null)".
+ */
+void uart_printf(const char* fmt, ...);
+void uart_vprintf(const char* fmt, va_list ap);
+
+/* Building blocks used by UART_PRINT(); each queues without starting TX */
+void uart_fmt_text(const char* str, uint32_t len);
+void uart_fmt_cstr(const char* str);
+void uart_fmt_u32(uint32_t value, uint32_t width, char pad);
+void uart_fmt_i32(int32_t value, uint32_t width, char pad);
+void uart_fmt_hex(uint32_t value, uint32_t width, char pad);
+void uart_fmt_fixed(int32_t value, uint32_t frac_digits);
+
+/*
+ * Compile-time specialized formatting.
+ * A line is written as a list of FMT_* items, so no format string is
+ * parsed at runtime, literal lengths are computed by the compiler and the
+ * transmitter is started once per line:
+ *
+ *     UART_PRINT(FMT_STR("Counter: "), FMT_U(counter), FMT_STR("\n"));
+ */
+#define UART_PRINT(...)     ((void)(__VA_ARGS__), uart_tx_start())
+
+#define FMT_STR(lit)        uart_fmt_text("" lit, sizeof(lit) - 1)   /* string literal */
+#define FMT_S(str)          uart_fmt_cstr(str)                       /* runtime string */
+#define FMT_U(v)            uart_fmt_u32((v), 0, ' ')
+#define FMT_UW(v, w)        uart_fmt_u32((v), (w), ' ')
+#define FMT_UZ(v, w)        uart_fmt_u32((v), (w), '0')
+#define FMT_D(v)            uart_fmt_i32((v), 0, ' ')
+#define FMT_DW(v, w)        uart_fmt_i32((v), (w), ' ')
+#define FMT_X(v)            uart_fmt_hex((v), 0, '0')
+#define FMT_XZ(v, w)        uart_fmt_hex((v), (w), '0')
+#define FMT_FIXED(v, n)     uart_fmt_fixed((v), (n))
+
+#endif /* UART_PRINTF_H */
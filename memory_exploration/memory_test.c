@@ -1,9 +1,11 @@
-// Memory addresses for exploration
-#define SRAM_BASE    0x20000000
-#define SRAM_SIZE    0x00010000
+#include <stdint.h>
 
-// Type definitions
-typedef unsigned int uint32_t;
+// Memory addresses for exploration, from the board config generated out of
+// simple_m33.repl by the shared HAL (../hal/boards/simple_m33.board)
+#include "board_config.h"
+
+#define SRAM_BASE    BOARD_SRAM_BASE
+#define SRAM_SIZE    BOARD_SRAM_SIZE
 
 // Simple variables in different memory locations
 volatile uint32_t global_var = 0x12345678;
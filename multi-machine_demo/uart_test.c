@@ -4,67 +4,32 @@
 // - Direct hardware register manipulation
 // - Minimal runtime environment without standard library
 
-// Type definitions for exact-width integers
-// These ensure consistent behavior across different architectures
-typedef unsigned int uint32_t;   // 32-bit unsigned integer for addresses and large values
-typedef unsigned char uint8_t;   // 8-bit unsigned integer for register values and characters
+// Exact-width integers come from the compiler's freestanding <stdint.h>;
+// everything board-specific comes from the shared HAL in ../hal:
+// - board_config.h is generated from hal/boards/riscv_hub.board and
+//   simple_platform.repl, so BOARD_UART0_BASE and BOARD_UART1_BASE always
+//   match the addresses Renode maps the UARTs at
+// - hal_ns16550.h holds static inline register accessors; with a constant
+//   base address every register access compiles to a single load or store
+// - hal_console.h is the polled console on UART0 (the "console" of the
+//   board file), compiled into libhal.a
+#include <stdint.h>
+#include "board_config.h"
+#include "hal_console.h"
+#include "hal_ns16550.h"
 
-// UART Memory-Mapped I/O Base Addresses
-// These addresses correspond to the peripheral memory regions defined in simple_platform.repl
-// Memory-mapped I/O allows us to control hardware by reading/writing to specific memory addresses
-#define UART0_BASE 0x10013000  // Console UART for debug output and system messages
-#define UART1_BASE 0x10023000  // Communication UART for inter-machine messaging via hub
-
-// UART Register Offsets (from NS16550 UART specification)
-// These offsets are added to the base address to access specific UART control registers
-#define UART_THR   0x00  // Transmit Holding Register - where we write data to send
-#define UART_LSR   0x14  // Line Status Register - shows UART transmission status
-
-// UART Line Status Register Bit Definitions
-// Individual bits in the LSR register indicate different UART states
-#define UART_LSR_THRE 0x20  // Transmit Holding Register Empty - bit 5, indicates TX ready  
-
-// Function: uart_putc - Send a single character via UART
-// This function demonstrates the fundamental embedded systems concept of polling I/O
-// Parameters:
-//   base: UART base address (UART0_BASE or UART1_BASE)
-//   c: Character to transmit
-static void uart_putc(uint32_t base, char c) {
-    // Create volatile pointers to UART registers
-    // 'volatile' keyword prevents compiler optimization - essential for memory-mapped I/O
-    // The compiler must read the actual hardware register every time, not cache the value
-    volatile uint8_t *lsr = (uint8_t*)(base + UART_LSR);  // Line Status Register pointer
-    volatile uint8_t *thr = (uint8_t*)(base + UART_THR);  // Transmit Holding Register pointer
-    
-    // Polling loop: Wait until transmit holding register is empty
-    // This implements busy-waiting - CPU repeatedly checks hardware status
-    // Alternative approach would be interrupt-driven I/O (more complex but more efficient)
-    while (!(*lsr & UART_LSR_THRE));  // Loop while THRE bit is 0 (transmitter busy)
-    
-    // Write character to transmit holding register
-    // This triggers the UART hardware to begin serial transmission
-    // Hardware will shift out bits according to configured baud rate, data format
-    *thr = c;
-}
-
-// Function: uart_puts - Send a null-terminated string via UART
-// This function builds on uart_putc to provide string transmission capability
+// Function: hub_puts - Send a null-terminated string via UART1 (the hub UART)
 // Demonstrates string processing in embedded systems without standard library
 // Parameters:
-//   base: UART base address (UART0_BASE or UART1_BASE)
 //   s: Pointer to null-terminated string to transmit
-static void uart_puts(uint32_t base, const char *s) {
-    // Iterate through string until null terminator
-    // This is a manual implementation of string traversal (no strlen() available)
+static void hub_puts(const char *s) {
     while (*s) {
-        // Handle newline character for proper terminal display
-        // Convert Unix LF (\n) to Windows CRLF (\r\n) for terminal compatibility
-        // Many terminal emulators expect carriage return before line feed
-        if (*s == '\n') uart_putc(base, '\r');  // Send carriage return first
-        
-        // Send the current character and advance string pointer
-        // Post-increment operator: use current value of s, then increment pointer
-        uart_putc(base, *s++);
+        // Convert Unix LF (\n) to CRLF (\r\n) for terminal compatibility
+        if (*s == '\n') ns16550_putc(BOARD_UART1_BASE, '\r');
+
+        // Polled transmit: wait for THRE in the Line Status Register, then
+        // write the Transmit Holding Register (see ns16550_putc())
+        ns16550_putc(BOARD_UART1_BASE, *s++);
     }
 }
 
@@ -79,17 +44,22 @@ void _start(void) {
     // This provides 1MB for program code/data, rest for stack/heap
     // Inline assembly ensures direct control over stack pointer register
     __asm__ volatile("li sp, 0x80100000");
+
+    // Program both UARTs for 8N1 at the board's baud rate
+    // Both are clocked from the same peripheral clock as the console
+    hal_console_init();
+    ns16550_configure(BOARD_UART1_BASE, BOARD_CONSOLE_CLOCK_HZ, BOARD_CONSOLE_BAUD);
     
     // Send startup message to console UART (UART0)
     // This demonstrates local system status reporting
     // UART0 is typically used for debug output and system console
-    uart_puts(UART0_BASE, "Machine starting...\n");
+    hal_console_puts("Machine starting...\n");
     
     // Send greeting message to communication UART (UART1)
     // This demonstrates inter-machine communication capability
     // UART1 is connected to the UART hub for multi-machine messaging
     // Other machines connected to the hub will receive this message
-    uart_puts(UART1_BASE, "Hello from machine!\n");
+    hub_puts("Hello from machine!\n");
     
     // Main program loop: Enter low-power wait state
     // WFI (Wait For Interrupt) instruction puts CPU in sleep mode